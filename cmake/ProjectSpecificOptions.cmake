@@ -16,6 +16,10 @@ cmake_dependent_option( PRINTER_DISPLAYS "Printer displays activation" OFF "CUST
 # default ON, change by user input if and only if condition allows (CUSTOM_DEBUG_HELPER_FUNCION=ON)
 cmake_dependent_option( LOGGER_DISPLAYS "Logger displays activation" ON "CUSTOM_DEBUG_HELPER_FUNCION" ON)
 # default ON, change by user input if and only if condition allows (CUSTOM_DEBUG_HELPER_FUNCION=ON)
+option( BUILD_BENCHMARKS "Build the benchmark executables under src/bench" OFF)
+# default OFF
+option( PLANNER_STATS "Record per-query search statistics in the planners" OFF)
+# default OFF, adds timing calls to the planners' inner loops
 
 if(CUSTOM_DEBUG_HELPER_FUNCION)
   add_definitions(-DCUSTOM_DEBUG_HELPER_FUNCION)
@@ -27,4 +31,8 @@ endif(PRINTER_DISPLAYS)
 
 if (LOGGER_DISPLAYS)
 add_definitions(-DENABLE_LOGGER_DISPLAY)
-endif(LOGGER_DISPLAYS)
\ No newline at end of file
+endif(LOGGER_DISPLAYS)
+
+if (PLANNER_STATS)
+add_definitions(-DENABLE_PLANNER_STATS)
+endif(PLANNER_STATS)
\ No newline at end of file
@@ -0,0 +1,445 @@
+/**
+ * @file planner_bench.cpp
+ * @author osamy
+ * @brief benchmarks every GPEngine_C planner on reproducible maps
+ * @details the sweep covers the map size, the map kind (random obstacles at a
+ * few densities, and mazes) and the planners, which differ in connectivity
+ * (A* and D* Lite move in 4 directions, the 8-connected A* variants and JPS
+ * in 8). all maps and queries come
+ * from seeded generators, so two runs with the same seed plan the same
+ * queries on the same maps.
+ * every configuration runs in its own child process, so the peak resident
+ * memory reported by getrusage belongs to that configuration alone.
+ * expansions per second are only reported when the planners record statistics
+ * (cmake option PLANNER_STATS), which also slows them down.
+ * single queries are answered through planInto() into a reused path. the
+ * heap allocations per query are counted in steady state, by answering the
+ * first queries once to warm up and then a second time; planners that keep
+ * all their scratch state between queries report 0.
+ * usage: planner_bench [queries per configuration] [seed] [sides...]
+ */
+
+/* C/C++ standard includes */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/* system includes */
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* project-specific includes */
+#include "arastar.hpp"
+#include "astar.hpp"
+#include "biastar.hpp"
+#include "distance_field.hpp"
+#include "dstarlite.hpp"
+#include "hpa.hpp"
+#include "jps.hpp"
+#include "landmarks.hpp"
+#include "lpastar.hpp"
+#include "utils.hpp"
+#include "wavefront.hpp"
+
+/** \brief number of heap allocations made by the process so far */
+static std::atomic<uint64_t> numAllocations{0};
+
+/**
+ * @brief counts every heap allocation of the benchmark
+ * @param size - number of bytes
+ * @return allocated memory
+ */
+void* operator new(const size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(0 == size ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief releases memory from the counting operator new
+ * @param p - memory to release
+ * @return void
+ */
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief releases memory from the counting operator new
+ * @param p - memory to release
+ * @return void
+ */
+void operator delete(void* p, const size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief kind of generated map
+ */
+enum map_kind_E
+{
+    MAP_RANDOM = 0,
+    MAP_MAZE
+};
+
+/**
+ * @brief a planner under test
+ */
+struct planner_S
+{
+    /** \brief name shown in the report */
+    std::string name;
+    /** \brief number of directions the planner moves in */
+    int connectivity;
+    /** \brief whether the queries are answered through planBatch */
+    bool batch;
+    /** \brief creates the planner on a map */
+    std::function<std::unique_ptr<planning::GPEngine_C>(std::shared_ptr<const OccupancyGrid_C>)> make;
+};
+
+/**
+ * @brief one configuration of the sweep
+ */
+struct config_S
+{
+    map_kind_E kind;
+    int64_t side;
+    double density;
+    const planner_S* planner;
+    size_t numQueries;
+    uint32_t seed;
+};
+
+/**
+ * @brief measurements of one configuration, sent from the child to the parent
+ */
+struct result_S
+{
+    /** \brief queries answered per second */
+    double qps = 0;
+    /** \brief nodes expanded per second, 0 without planner statistics */
+    double eps = 0;
+    /** \brief median latency of a query in microseconds, not measured for batches */
+    double p50 = 0;
+    /** \brief 99th percentile latency of a query in microseconds, not measured for batches */
+    double p99 = 0;
+    /** \brief heap allocations per query in steady state, not measured for batches */
+    double allocs = 0;
+    /** \brief number of queries a path was found for */
+    size_t found = 0;
+    /** \brief number of queries */
+    size_t queries = 0;
+};
+
+/**
+ * @brief the planners under test
+ * @return list of planners
+ */
+static const std::vector<planner_S>& planners()
+{
+    using map_T = std::shared_ptr<const OccupancyGrid_C>;
+    static const std::vector<planner_S> list = {
+        {"AStar_C", 4, false, [](map_T m) { return std::make_unique<planning::AStar_C>(m); }},
+        {"AStar_C batch", 4, true, [](map_T m) { return std::make_unique<planning::AStar_C>(m); }},
+        {"AStar_C ALT", 4, false,
+         [](map_T m) {
+             auto aStar = std::make_unique<planning::AStar_C>(m);
+             aStar->setLandmarks(planning::Landmarks_C::build(m, 8));
+             return aStar;
+         }},
+        {"ARAStar_C 20k", 4, false,
+         [](map_T m) {
+             auto araStar = std::make_unique<planning::ARAStar_C>(m);
+             araStar->setBudget(std::chrono::nanoseconds::max(), 20000);
+             return araStar;
+         }},
+        {"AStar8_C", 8, false, [](map_T m) { return std::make_unique<planning::AStar8_C>(m); }},
+        {"BiAStar_C", 4, false, [](map_T m) { return std::make_unique<planning::BiAStar_C>(m); }},
+        {"BiAStar8_C", 8, false, [](map_T m) { return std::make_unique<planning::BiAStar8_C>(m); }},
+        {"Dijkstra_C", 4, false, [](map_T m) { return std::make_unique<planning::Dijkstra_C>(m); }},
+        {"BiDijkstra_C", 4, false, [](map_T m) { return std::make_unique<planning::BiDijkstra_C>(m); }},
+        {"DistanceField_C", 4, false, [](map_T m) { return std::make_unique<planning::DistanceField_C>(m); }},
+        {"DStarLite_C", 4, false, [](map_T m) { return std::make_unique<planning::DStarLite_C>(m); }},
+        {"HPA_C", 4, false, [](map_T m) { return std::make_unique<planning::HPA_C>(m); }},
+        {"JPS_C cell", 8, false,
+         [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_CELL); }},
+        {"JPS_C word", 8, false,
+         [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_WORD); }},
+        {"JPS_C batch", 8, true, [](map_T m) { return std::make_unique<planning::JPS_C>(m); }},
+        {"LPAStar_C", 4, false, [](map_T m) { return std::make_unique<planning::LPAStar_C>(m); }},
+        {"WavefrontField_C", 4, false, [](map_T m) { return std::make_unique<planning::WavefrontField_C>(m); }},
+    };
+    return list;
+}
+
+/**
+ * @brief generates the map of a configuration
+ * @param cfg - configuration
+ * @return generated map
+ */
+static std::shared_ptr<const OccupancyGrid_C> makeMap(const config_S& cfg)
+{
+    auto grid = std::make_shared<OccupancyGrid_C>(cfg.side, cfg.side, 0);
+    if (MAP_MAZE == cfg.kind)
+    {
+        makeMazeGrid(*grid, cfg.seed);
+    }
+    else
+    {
+        makeGrid(*grid, cfg.seed, cfg.density);
+    }
+    return grid;
+}
+
+/**
+ * @brief draws start/goal pairs on free cells of a map
+ * @param grid - map
+ * @param numQueries - number of pairs
+ * @param seed - seed of the generator
+ * @return queries, empty if no free cell was found
+ */
+static std::vector<std::pair<Node_C, Node_C>> makeQueries(const OccupancyGrid_C& grid,
+                                                          const size_t numQueries, const uint32_t seed)
+{
+    std::mt19937 eng(seed);
+    std::uniform_int_distribution<int64_t> cell(0, grid.numCells() - 1);
+    const auto freeNode = [&]() {
+        for (int attempt = 0; attempt < 1000; attempt++)
+        {
+            if (const int64_t i = cell(eng); 0 == grid[i])
+            {
+                const int64_t x = i / grid.cols();
+                const int64_t y = i % grid.cols();
+                return Node_C(x, y, 0, 0, i, i);
+            }
+        }
+        return Node_C(-1, -1);
+    };
+
+    std::vector<std::pair<Node_C, Node_C>> queries;
+    for (size_t q = 0; q < numQueries; q++)
+    {
+        const Node_C start = freeNode();
+        const Node_C goal = freeNode();
+        if (start.x_ < 0 || goal.x_ < 0)
+        {
+            return {};
+        }
+        queries.emplace_back(start, goal);
+    }
+    return queries;
+}
+
+/**
+ * @brief runs one configuration
+ * @param cfg - configuration
+ * @return measurements
+ */
+static result_S runConfig(const config_S& cfg)
+{
+    using clock_T = std::chrono::steady_clock;
+    const auto map = makeMap(cfg);
+    const auto queries = makeQueries(*map, cfg.numQueries, cfg.seed + 1);
+    auto planner = cfg.planner->make(map);
+
+    result_S res;
+    res.queries = queries.size();
+    if (queries.empty())
+    {
+        return res;
+    }
+
+    if (cfg.planner->batch)
+    {
+        /* untimed warm-up, sizes the search state of the planner */
+        planner->plan(queries.front().first, queries.front().second);
+        const auto t0 = clock_T::now();
+        std::vector<planning::SearchStats_S> stats;
+        const auto results = planner->planBatch(queries, 0, &stats);
+        const double secs = std::chrono::duration<double>(clock_T::now() - t0).count();
+        uint64_t expanded = 0;
+        for (size_t q = 0; q < results.size(); q++)
+        {
+            res.found += std::get<0>(results[q]) ? 1 : 0;
+            expanded += stats[q].expanded;
+        }
+        res.qps = static_cast<double>(queries.size()) / secs;
+        res.eps = static_cast<double>(expanded) / secs;
+        return res;
+    }
+
+    /* untimed warm-up on the first queries, sizes the search state of the
+     * planner and the path, then the same queries again in steady state */
+    constexpr size_t numWarmUp = 10;
+    const size_t numSteady = std::min(numWarmUp, queries.size());
+    std::vector<Node_C> path;
+    for (size_t q = 0; q < numSteady; q++)
+    {
+        planner->planInto(queries[q].first, queries[q].second, path);
+    }
+    const uint64_t allocsBefore = numAllocations.load();
+    for (size_t q = 0; q < numSteady; q++)
+    {
+        planner->planInto(queries[q].first, queries[q].second, path);
+    }
+    res.allocs = static_cast<double>(numAllocations.load() - allocsBefore) / static_cast<double>(numSteady);
+
+    std::vector<double> latencies;
+    latencies.reserve(queries.size());
+    double total = 0;
+    uint64_t expanded = 0;
+    for (const auto& [start, goal] : queries)
+    {
+        const auto t0 = clock_T::now();
+        const bool found = planner->planInto(start, goal, path);
+        const double secs = std::chrono::duration<double>(clock_T::now() - t0).count();
+        latencies.push_back(1e6 * secs);
+        total += secs;
+        res.found += found ? 1 : 0;
+        expanded += planner->getStats().expanded;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    res.qps = static_cast<double>(queries.size()) / total;
+    res.eps = static_cast<double>(expanded) / total;
+    res.p50 = latencies[latencies.size() / 2];
+    res.p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    return res;
+}
+
+/**
+ * @brief runs one configuration in a child process
+ * @param cfg - configuration
+ * @param res - measurements of the child
+ * @param maxRssKb - peak resident memory of the child in kilobytes
+ * @return whether the child finished successfully
+ */
+static bool runInChild(const config_S& cfg, result_S& res, long& maxRssKb)
+{
+    int fds[2];
+    if (0 != pipe(fds))
+    {
+        return false;
+    }
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (0 == pid)
+    {
+        close(fds[0]);
+        const result_S childRes = runConfig(cfg);
+        const bool ok = sizeof(childRes) == write(fds[1], &childRes, sizeof(childRes));
+        close(fds[1]);
+        _exit(ok ? 0 : 1);
+    }
+
+    close(fds[1]);
+    const bool readOk = sizeof(res) == read(fds[0], &res, sizeof(res));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage = {};
+    wait4(pid, &status, 0, &usage);
+    maxRssKb = usage.ru_maxrss;
+    return readOk && WIFEXITED(status) && 0 == WEXITSTATUS(status);
+}
+
+int main(int argc, char** argv)
+{
+    const size_t numQueries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100;
+    const uint32_t seed = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 42;
+    std::vector<int64_t> sides;
+    for (int a = 3; a < argc; a++)
+    {
+        sides.push_back(std::strtoll(argv[a], nullptr, 10));
+    }
+    if (sides.empty())
+    {
+        sides = {64, 256, 1024};
+    }
+
+    /* the longest name and two spaces, so no name runs into the next column */
+    size_t nameWidth = 0;
+    for (const auto& planner : planners())
+    {
+        nameWidth = std::max(nameWidth, planner.name.size() + 2);
+    }
+
+    std::cout << std::left << std::setw(8) << "map"
+              << std::setw(8) << "side"
+              << std::setw(9) << "density"
+              << std::setw(static_cast<int>(nameWidth)) << "planner"
+              << std::setw(6) << "conn"
+              << std::setw(12) << "queries/s"
+              << std::setw(14) << "expanded/s"
+              << std::setw(12) << "p50 us"
+              << std::setw(12) << "p99 us"
+              << std::setw(10) << "allocs/q"
+              << std::setw(10) << "found"
+              << "peak RSS MB" << '\n';
+
+    const std::vector<std::pair<map_kind_E, double>> maps = {
+        {MAP_RANDOM, 0.0}, {MAP_RANDOM, 0.1}, {MAP_RANDOM, 0.25}, {MAP_MAZE, 0.0}};
+
+    for (const int64_t side : sides)
+    {
+        for (const auto& [kind, density] : maps)
+        {
+            for (const auto& planner : planners())
+            {
+                const config_S cfg{kind, side, density, &planner, numQueries,
+                                   seed + static_cast<uint32_t>(side)};
+                result_S res;
+                long maxRssKb = 0;
+                std::cout << std::left << std::setw(8) << ((MAP_MAZE == kind) ? "maze" : "random")
+                          << std::setw(8) << side
+                          << std::setw(9) << ((MAP_MAZE == kind) ? std::string("-") : std::to_string(density).substr(0, 4))
+                          << std::setw(static_cast<int>(nameWidth)) << planner.name
+                          << std::setw(6) << planner.connectivity;
+                if (!runInChild(cfg, res, maxRssKb))
+                {
+                    std::cout << "failed" << '\n';
+                    continue;
+                }
+                std::cout << std::setw(12) << std::fixed << std::setprecision(1) << res.qps;
+                if (planning::SearchStats_S::enabled)
+                {
+                    std::cout << std::setw(14) << std::setprecision(0) << res.eps << std::setprecision(1);
+                }
+                else
+                {
+                    std::cout << std::setw(14) << "-";
+                }
+                if (planner.batch)
+                {
+                    std::cout << std::setw(12) << "-" << std::setw(12) << "-" << std::setw(10) << "-";
+                }
+                else
+                {
+                    std::cout << std::setw(12) << res.p50 << std::setw(12) << res.p99 << std::setw(10) << res.allocs;
+                }
+                std::cout << std::setw(10) << (std::to_string(res.found) + "/" + std::to_string(res.queries))
+                          << static_cast<double>(maxRssKb) / 1024.0 << '\n';
+                std::cout << std::defaultfloat;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file prioq_bench.cpp
+ * @author osamy
+ * @brief compares PrioQ_C with the lazy-deletion queue it replaced
+ * @details the workload mimics an incremental planner: keys of queued nodes
+ * are updated many times, nodes are removed from the middle of the queue and
+ * the top is popped. both queues see the same operations. before timing,
+ * PrioQ_C is checked against a brute-force reference on the same workload.
+ * (the old queue can return a stale top after an update, so its pops are not
+ * compared.)
+ */
+
+/* C/C++ standard includes */
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/* project-specific includes */
+#include "utils.hpp"
+
+/**
+ * @brief the previous PrioQ_C: a priority queue with a set on the side,
+ * entries that were removed or updated are skipped lazily
+ */
+class LazyPrioQ_C
+{
+public:
+    void insert(const node_key_pair_S& t)
+    {
+        if (auto p = s.insert(t); !p.second)
+        {
+            s.erase(t);
+            s.insert(t);
+        }
+        pq.push(t);
+    }
+
+    void pop()
+    {
+        skipStale();
+        if (s.empty())
+        {
+            return;
+        }
+        s.erase(pq.top());
+        pq.pop();
+        skipStale();
+    }
+
+    const node_key_pair_S& top() const { return pq.top(); }
+
+    bool empty() const { return s.empty(); }
+
+    void remove(const node_key_pair_S& t)
+    {
+        s.erase(t);
+        skipStale();
+    }
+
+    /** @brief number of entries held by the heap, including stale ones */
+    size_t heapSize() const { return pq.size(); }
+
+private:
+    std::priority_queue<node_key_pair_S, std::vector<node_key_pair_S>, std::greater<node_key_pair_S>> pq;
+    std::unordered_set<node_key_pair_S, std::hash<node_key_pair_S>, compare_node_key_pair_coords_S> s;
+
+    void skipStale()
+    {
+        while (!pq.empty())
+        {
+            if (const auto it = s.find(pq.top()); it == s.end() || pq.top().key != it->key)
+            {
+                pq.pop();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+};
+
+/**
+ * @brief operation of the workload
+ */
+struct op_S
+{
+    /** \brief 0: insert/update, 1: remove, 2: pop */
+    int type;
+    /** \brief node and key used by insert/update and remove */
+    node_key_pair_S nkp;
+};
+
+/**
+ * @brief generates a reproducible workload
+ * @param side - side of the grid the nodes are taken from
+ * @param numOps - number of operations
+ * @param seed - seed of the generator
+ * @return vector of operations
+ */
+static std::vector<op_S> makeWorkload(const int64_t side, const size_t numOps, const uint32_t seed)
+{
+    std::mt19937 eng(seed);
+    std::uniform_int_distribution<int64_t> coord(0, side - 1);
+    std::uniform_int_distribution<int> key(0, 4 * static_cast<int>(side));
+    std::uniform_int_distribution<int> type(0, 9);
+
+    std::vector<op_S> ops(numOps);
+    for (auto& op : ops)
+    {
+        const int t = type(eng);
+        /* 60% insert/update, 20% remove, 20% pop */
+        op.type = (t < 6) ? 0 : ((t < 8) ? 1 : 2);
+        const int64_t x = coord(eng);
+        const int64_t y = coord(eng);
+        const double k = key(eng);
+        op.nkp = {Node_C(x, y, 0, 0, x * side + y, 0), {k, k}};
+    }
+    return ops;
+}
+
+/**
+ * @brief runs the workload on a queue
+ * @param q - queue under test
+ * @param ops - workload
+ * @param popped - keys popped, in order
+ * @return elapsed time in seconds
+ */
+template <typename Q>
+static double run(Q& q, const std::vector<op_S>& ops, std::vector<double>& popped)
+{
+    popped.clear();
+    popped.reserve(ops.size());
+    const auto t0 = std::chrono::steady_clock::now();
+    for (const auto& op : ops)
+    {
+        if (0 == op.type)
+        {
+            q.insert(op.nkp);
+        }
+        else if (1 == op.type)
+        {
+            q.remove(op.nkp);
+        }
+        else if (!q.empty())
+        {
+            popped.push_back(q.top().key.first);
+            q.pop();
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+/**
+ * @brief checks that PrioQ_C always pops a smallest key
+ * @param ops - workload
+ * @return whether every pop matched the reference
+ */
+static bool checkAgainstReference(const std::vector<op_S>& ops)
+{
+    PrioQ_C q;
+    std::map<std::pair<int64_t, int64_t>, double> ref;
+    for (const auto& op : ops)
+    {
+        const auto coords = std::make_pair(op.nkp.node.x_, op.nkp.node.y_);
+        if (0 == op.type)
+        {
+            q.insert(op.nkp);
+            ref[coords] = op.nkp.key.first;
+        }
+        else if (1 == op.type)
+        {
+            q.remove(op.nkp);
+            ref.erase(coords);
+        }
+        else if (!q.empty())
+        {
+            double best = std::numeric_limits<double>::max();
+            for (const auto& [c, k] : ref)
+            {
+                best = std::min(best, k);
+            }
+            if (q.top().key.first != best)
+            {
+                return false;
+            }
+            ref.erase(std::make_pair(q.top().node.x_, q.top().node.y_));
+            q.pop();
+        }
+        if (q.size() != ref.size())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t numOps = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const uint32_t seed = 42;
+
+    if (!checkAgainstReference(makeWorkload(16, 20000, seed)))
+    {
+        std::cout << "PrioQ_C disagrees with the reference queue" << '\n';
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(8) << "side"
+              << std::setw(16) << "queue"
+              << std::setw(14) << "ns/op"
+              << std::setw(14) << "final size"
+              << "heap entries" << '\n';
+
+    for (const int64_t side : {64, 256, 1024})
+    {
+        const auto ops = makeWorkload(side, numOps, seed);
+        std::vector<double> poppedLazy;
+        std::vector<double> poppedIndexed;
+
+        LazyPrioQ_C lazy;
+        const double tLazy = run(lazy, ops, poppedLazy);
+        const size_t lazyEntries = lazy.heapSize();
+        size_t lazySize = 0;
+        while (!lazy.empty())
+        {
+            lazySize++;
+            lazy.pop();
+        }
+
+        PrioQ_C indexed;
+        const double tIndexed = run(indexed, ops, poppedIndexed);
+
+        std::cout << std::left << std::setw(8) << side
+                  << std::setw(16) << "lazy (old)"
+                  << std::setw(14) << 1e9 * tLazy / numOps
+                  << std::setw(14) << lazySize
+                  << lazyEntries << '\n';
+        std::cout << std::left << std::setw(8) << side
+                  << std::setw(16) << "PrioQ_C"
+                  << std::setw(14) << 1e9 * tIndexed / numOps
+                  << std::setw(14) << indexed.size()
+                  << indexed.size() << '\n';
+    }
+    return 0;
+}
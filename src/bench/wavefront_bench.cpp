@@ -0,0 +1,181 @@
+/**
+ * @file wavefront_bench.cpp
+ * @author osamy
+ * @brief compares the wavefront distance field with the queue and heap based searches
+ * @details on every map, the distances of all cells to one goal are computed
+ * three ways: by WavefrontField_C, by the breadth first search of
+ * DistanceField_C, and by Dijkstra_C, which keeps its open list in a heap.
+ * Dijkstra_C plans to the reachable cell farthest from the goal, so it settles
+ * every cell the other two reach; the three costs of that cell are checked to
+ * agree. then queries from random starts to the same goal are answered by
+ * AStar_C, and by WavefrontField_C following the field it kept, the perfect
+ * heuristic.
+ * maps and queries come from seeded generators, as in planner_bench.
+ * usage: wavefront_bench [queries per map] [seed] [sides...]
+ */
+
+/* C/C++ standard includes */
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/* project-specific includes */
+#include "astar.hpp"
+#include "distance_field.hpp"
+#include "utils.hpp"
+#include "wavefront.hpp"
+
+/**
+ * @brief draws a free cell of a map
+ * @param grid - map
+ * @param eng - generator
+ * @return free cell, at (-1, -1) if none was found
+ */
+static Node_C freeCell(const OccupancyGrid_C& grid, std::mt19937& eng)
+{
+    std::uniform_int_distribution<int64_t> cell(0, grid.numCells() - 1);
+    for (int attempt = 0; attempt < 1000; attempt++)
+    {
+        if (const int64_t i = cell(eng); 0 == grid[i])
+        {
+            return Node_C(i / grid.cols(), i % grid.cols(), 0, 0, i, i);
+        }
+    }
+    return Node_C(-1, -1);
+}
+
+/**
+ * @brief times a function
+ * @param f - function to be timed
+ * @return wall time of the call in milliseconds
+ */
+template <typename F>
+static double timeMs(F&& f)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv)
+{
+    const size_t numQueries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100;
+    const uint32_t seed = (argc > 2) ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 42;
+    std::vector<int64_t> sides;
+    for (int a = 3; a < argc; a++)
+    {
+        sides.push_back(std::strtoll(argv[a], nullptr, 10));
+    }
+    if (sides.empty())
+    {
+        sides = {1024, 2048, 4096, 8192};
+    }
+
+    std::cout << std::left << std::setw(8) << "map"
+              << std::setw(8) << "side"
+              << std::setw(9) << "density"
+              << std::setw(12) << "wave ms"
+              << std::setw(12) << "bfs ms"
+              << std::setw(12) << "heap ms"
+              << std::setw(14) << "A* us/query"
+              << std::setw(16) << "wave us/query"
+              << "costs" << '\n';
+
+    /* density < 0 is a maze */
+    for (const int64_t side : sides)
+    {
+        for (const double density : {0.0, 0.1, 0.25, -1.0})
+        {
+            auto map = std::make_shared<OccupancyGrid_C>(side, side, 0);
+            if (density < 0)
+            {
+                makeMazeGrid(*map, seed + static_cast<uint32_t>(side));
+            }
+            else
+            {
+                makeGrid(*map, seed + static_cast<uint32_t>(side), density);
+            }
+            std::mt19937 eng(seed);
+            const Node_C goal = freeCell(*map, eng);
+            std::vector<Node_C> starts;
+            for (size_t q = 0; q < numQueries; q++)
+            {
+                starts.push_back(freeCell(*map, eng));
+            }
+            std::cout << std::left << std::setw(8) << ((density < 0) ? "maze" : "random")
+                      << std::setw(8) << side
+                      << std::setw(9) << ((density < 0) ? std::string("-") : std::to_string(density).substr(0, 4));
+            if (goal.x_ < 0)
+            {
+                std::cout << "no free cell" << '\n';
+                continue;
+            }
+
+            planning::WavefrontField_C wave(map);
+            const double waveMs = timeMs([&]() { wave.distance(goal, goal); });
+            Node_C farthest = goal;
+            double farthestCost = 0;
+            for (int64_t x = 0; x < side; x++)
+            {
+                for (int64_t y = 0; y < side; y++)
+                {
+                    const double d = wave.distance(Node_C(x, y), goal);
+                    if (0 == (*map)(x, y) && d > farthestCost && d < std::numeric_limits<double>::infinity())
+                    {
+                        farthest = Node_C(x, y);
+                        farthestCost = d;
+                    }
+                }
+            }
+
+            double bfsCost = 0;
+            double bfsMs = 0;
+            {
+                planning::DistanceField_C field(map);
+                bfsMs = timeMs([&]() { bfsCost = field.distance(goal, farthest); });
+            }
+            double heapCost = 0;
+            double heapMs = 0;
+            {
+                planning::Dijkstra_C dijkstra(map);
+                std::vector<Node_C> path;
+                heapMs = timeMs([&]() { dijkstra.planInto(goal, farthest, path); });
+                heapCost = path.empty() ? 0 : path.front().cost_;
+            }
+
+            std::vector<Node_C> path;
+            double aStarMs = 0;
+            {
+                planning::AStar_C aStar(map);
+                aStarMs = timeMs([&]() {
+                    for (const auto& start : starts)
+                    {
+                        aStar.planInto(start, goal, path);
+                    }
+                });
+            }
+            const double waveQueryMs = timeMs([&]() {
+                for (const auto& start : starts)
+                {
+                    wave.planInto(start, goal, path);
+                }
+            });
+
+            const bool agree = (farthestCost == bfsCost) && (farthestCost == heapCost);
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(12) << waveMs
+                      << std::setw(12) << bfsMs
+                      << std::setw(12) << heapMs
+                      << std::setw(14) << 1e3 * aStarMs / static_cast<double>(starts.size())
+                      << std::setw(16) << 1e3 * waveQueryMs / static_cast<double>(starts.size())
+                      << (agree ? "agree" : "DIFFER") << '\n';
+        }
+    }
+    return 0;
+}
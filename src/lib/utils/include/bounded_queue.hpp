@@ -0,0 +1,147 @@
+/**
+ * @file bounded_queue.hpp
+ * @author osamy
+ * @brief bounded lock-free multi-producer multi-consumer queue
+ */
+
+#ifndef BOUNDED_QUEUE_H_
+#define BOUNDED_QUEUE_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief fixed capacity queue that never blocks and never allocates after construction
+ * @details every slot carries a sequence number telling whether it is ready to
+ * be written or read for a given lap around the ring. a producer claims a
+ * position with a compare-exchange on the tail, writes the slot, then
+ * publishes it by advancing the slot's sequence; consumers do the same on the
+ * head. a full or empty queue is reported instead of waited on.
+ * @tparam T - element type, default constructible and move assignable
+ */
+template <typename T>
+class BoundedQueue_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param capacity - number of elements the queue can hold, rounded up to a power of 2
+     */
+    explicit BoundedQueue_C(const size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        slots_ = std::make_unique<slot_S[]>(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue_C(const BoundedQueue_C&) = delete;
+    BoundedQueue_C& operator=(const BoundedQueue_C&) = delete;
+
+    /**
+     * @brief number of elements the queue can hold
+     * @return capacity
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief appends an element unless the queue is full
+     * @param value - element to be moved in, left untouched if the queue is full
+     * @return bool whether the element was appended
+     */
+    bool tryPush(T&& value)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot_S& slot = slots_[pos & mask_];
+            const size_t seq = slot.seq.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+            if (0 == diff)
+            {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* the slot still holds the element of the previous lap */
+                return false;
+            }
+            else
+            {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief removes the oldest element unless the queue is empty
+     * @param value - receives the element
+     * @return bool whether an element was removed
+     */
+    bool tryPop(T& value)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot_S& slot = slots_[pos & mask_];
+            const size_t seq = slot.seq.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+            if (0 == diff)
+            {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(slot.value);
+                    /* ready to be written on the next lap */
+                    slot.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* the slot has not been written for this lap yet */
+                return false;
+            }
+            else
+            {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief element with the sequence number guarding it
+     */
+    struct slot_S
+    {
+        /** \brief pos while free for position pos, pos + 1 once written for it */
+        std::atomic<size_t> seq;
+        /** \brief element */
+        T value;
+    };
+
+    /** \brief ring of capacity() slots */
+    std::unique_ptr<slot_S[]> slots_;
+    /** \brief capacity() - 1, maps a position to its slot */
+    size_t mask_ = 0;
+    /** \brief next position to be read, apart from the tail to avoid false sharing */
+    alignas(64) std::atomic<size_t> head_{0};
+    /** \brief next position to be written */
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+#endif /* BOUNDED_QUEUE_H_ */
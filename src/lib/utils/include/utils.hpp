@@ -14,7 +14,9 @@
  */
 #include <iostream>
 #include <stdint.h>
+#include <algorithm>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <limits>
@@ -27,6 +29,12 @@
 #include <unistd.h>
 #include <linux/limits.h>
 #include <libgen.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "bounded_queue.hpp"
 
 /* define colors */
 #define RESET           "\x1b[0m"
@@ -79,6 +87,461 @@ enum data_logger_E
 
 /* constants */
 constexpr int64_t spacing_for_grid = 10;
+/** \brief number of records Logger_C::log() can queue ahead of the writer thread */
+constexpr size_t logger_queue_capacity = 1024;
+/** \brief size of the buffer the logger's writes are gathered in */
+constexpr size_t logger_buffer_size = 1 << 20;
+
+/**
+ * @brief contiguous row-major 2D grid
+ * @details all cells live in a single allocation, so neighbouring cells of a
+ * row are adjacent in memory and a lookup is one multiply-add away.
+ * the cell type is a template parameter so that occupancy maps can use a
+ * compact type (see OccupancyGrid_C) while cost layers can use double.
+ * the cells are either owned by the grid or, for a grid made over external
+ * storage such as a memory mapped map file (see loadMapFile), kept alive by a
+ * shared owner. copying a grid always copies its cells into storage owned by
+ * the copy, so a copy can be changed without touching the source.
+ */
+template <typename T>
+class Grid_C
+{
+public:
+    /**
+     * @brief default constructor, creates an empty grid
+     */
+    Grid_C() = default;
+
+    /**
+     * @brief constructor
+     * @param rows - number of rows (x dimension)
+     * @param cols - number of columns (y dimension)
+     * @param init - initial value of every cell
+     */
+    Grid_C(const int64_t rows, const int64_t cols, const T init = T{})
+      : rows_(rows), cols_(cols), cells_(static_cast<size_t>(rows * cols), init), data_(cells_.data()) {}
+
+    /**
+     * @brief constructor over cells the grid does not own
+     * @param rows - number of rows (x dimension)
+     * @param cols - number of columns (y dimension)
+     * @param cells - rows * cols row-major cells
+     * @param owner - keeps the cells alive for as long as the grid exists
+     */
+    Grid_C(const int64_t rows, const int64_t cols, T* const cells, std::shared_ptr<void> owner)
+      : rows_(rows), cols_(cols), data_(cells), owner_(std::move(owner)) {}
+
+    /**
+     * @brief copy constructor
+     * @param g - grid to be copied
+     * @details the copy owns its cells, even if g does not
+     */
+    Grid_C(const Grid_C& g)
+      : rows_(g.rows_), cols_(g.cols_), cells_(g.data_, g.data_ + g.numCells()), data_(cells_.data()) {}
+
+    /**
+     * @brief move constructor
+     * @param g - grid to be moved, left empty
+     */
+    Grid_C(Grid_C&& g) noexcept
+      : rows_(g.rows_), cols_(g.cols_), cells_(std::move(g.cells_)), data_(g.data_), owner_(std::move(g.owner_))
+    {
+        g.rows_ = 0;
+        g.cols_ = 0;
+        g.data_ = nullptr;
+    }
+
+    /**
+     * @brief copy and move assignment
+     * @param g - grid to be assigned, copied or moved in by the caller
+     * @return reference to this grid
+     */
+    Grid_C& operator=(Grid_C g) noexcept
+    {
+        std::swap(rows_, g.rows_);
+        std::swap(cols_, g.cols_);
+        /* swapping vectors keeps their buffers, so data_ stays valid */
+        std::swap(cells_, g.cells_);
+        std::swap(data_, g.data_);
+        std::swap(owner_, g.owner_);
+        return *this;
+    }
+
+    /**
+     * @brief number of rows
+     * @return number of rows
+     */
+    int64_t rows() const { return rows_; }
+
+    /**
+     * @brief number of columns
+     * @return number of columns
+     */
+    int64_t cols() const { return cols_; }
+
+    /**
+     * @brief total number of cells
+     * @return rows * cols
+     */
+    int64_t numCells() const { return rows_ * cols_; }
+
+    /**
+     * @brief checks whether the grid has no cells
+     * @return bool whether the grid is empty
+     */
+    bool empty() const { return 0 == numCells(); }
+
+    /**
+     * @brief checks whether the cells are owned by the grid
+     * @return bool, false for a grid over external storage
+     */
+    bool ownsCells() const { return !owner_; }
+
+    /**
+     * @brief linear index of a cell
+     * @param x - row
+     * @param y - column
+     * @return linear index of the cell in the row-major storage
+     */
+    int64_t index(const int64_t x, const int64_t y) const { return x * cols_ + y; }
+
+    /**
+     * @brief access a cell by its coordinates
+     * @param x - row
+     * @param y - column
+     * @return reference to the cell
+     */
+    T& operator()(const int64_t x, const int64_t y) { return data_[index(x, y)]; }
+
+    /**
+     * @brief access a cell by its coordinates
+     * @param x - row
+     * @param y - column
+     * @return const reference to the cell
+     */
+    const T& operator()(const int64_t x, const int64_t y) const { return data_[index(x, y)]; }
+
+    /**
+     * @brief access a cell by its linear index
+     * @param idx - linear index
+     * @return reference to the cell
+     */
+    T& operator[](const int64_t idx) { return data_[idx]; }
+
+    /**
+     * @brief access a cell by its linear index
+     * @param idx - linear index
+     * @return const reference to the cell
+     */
+    const T& operator[](const int64_t idx) const { return data_[idx]; }
+
+    /**
+     * @brief raw access to the row-major storage
+     * @return pointer to the first cell
+     */
+    T* data() { return data_; }
+
+    /**
+     * @brief raw access to the row-major storage
+     * @return const pointer to the first cell
+     */
+    const T* data() const { return data_; }
+
+    /**
+     * @brief sets every cell to the given value
+     * @param value - value to be set
+     * @return void
+     */
+    void fill(const T value) { std::fill(data_, data_ + numCells(), value); }
+
+    /**
+     * @brief overload == operator for comparison
+     * @param g - grid to be compared
+     * @return whether dimensions and cells are equal
+     */
+    bool operator==(const Grid_C& g) const
+    {
+        return rows_ == g.rows_ && cols_ == g.cols_ && std::equal(data_, data_ + numCells(), g.data_);
+    }
+
+private:
+    /** \brief number of rows */
+    int64_t rows_ = 0;
+    /** \brief number of columns */
+    int64_t cols_ = 0;
+    /** \brief row-major cells, empty if the grid does not own its cells */
+    std::vector<T> cells_;
+    /** \brief first cell, in cells_ or in the external storage */
+    T* data_ = nullptr;
+    /** \brief keeps external storage alive, null if the grid owns its cells */
+    std::shared_ptr<void> owner_;
+};
+
+/**
+ * @brief occupancy grid used by the planners
+ * @details cell values: 0 free, 1 obstacle, from 2 up a free cell with that
+ * traversal cost (see cellCost). the planners differ in what they read:
+ * - A*, ARA*, bidirectional A*, HPA*, LPA*, DistanceField_C and Landmarks_C
+ *   use the traversal costs
+ * - D* Lite and JPS treat every non-zero value as an obstacle
+ * - WavefrontField_C treats every value but 1 as a free cell of cost 1
+ * the values 2..5 are also used when marking a copy of the grid for display
+ * (see printGrid).
+ */
+using OccupancyGrid_C = Grid_C<uint8_t>;
+
+/**
+ * @brief copies a grid into a larger one with a border around it
+ * @param grid - source grid
+ * @param border - width of the border on every side
+ * @param value - value of the border cells
+ * @return grid of (rows + 2 * border) x (cols + 2 * border) cells, where cell
+ * (x, y) of the source is cell (x + border, y + border)
+ * @details lets neighbour lookups near the edge land on border cells instead
+ * of being bounds checked.
+ */
+template <typename T, typename U>
+Grid_C<T> padGrid(const Grid_C<U>& grid, const int64_t border, const T value)
+{
+    Grid_C<T> padded(grid.rows() + 2 * border, grid.cols() + 2 * border, value);
+    for (int64_t x = 0; x < grid.rows(); x++)
+    {
+        for (int64_t y = 0; y < grid.cols(); y++)
+        {
+            padded(x + border, y + border) = static_cast<T>(grid(x, y));
+        }
+    }
+    return padded;
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of the size and the cells of a grid
+ * @param grid - grid to be hashed
+ * @return hash, equal for grids of equal size and cells
+ * @details identifies a version of a map, e.g. to tell whether data computed
+ * from a map and stored in a file still belongs to it
+ */
+template <typename T>
+uint64_t hashGrid(const Grid_C<T>& grid)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const auto add = [&hash](const unsigned char* bytes, const size_t length) {
+        for (size_t i = 0; i < length; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    };
+    const int64_t size[2] = {grid.rows(), grid.cols()};
+    add(reinterpret_cast<const unsigned char*>(size), sizeof(size));
+    add(reinterpret_cast<const unsigned char*>(grid.data()), static_cast<size_t>(grid.numCells()) * sizeof(T));
+    return hash;
+}
+
+/**
+ * @brief bit-packed occupancy grid, one bit per cell (1 blocked, 0 free)
+ * @details each row is stored as 64-bit words so that runs of cells can be
+ * tested a word at a time. cells outside the grid read as blocked.
+ * built transposed, the rows of the bit grid are the columns of the source grid,
+ * which allows column runs to be scanned the same way.
+ */
+class BitGrid_C
+{
+public:
+    /**
+     * @brief default constructor, creates an empty grid
+     */
+    BitGrid_C() = default;
+
+    /**
+     * @brief constructor
+     * @param grid - occupancy grid, any non-zero cell is blocked
+     * @param transpose - whether to store the columns of grid as rows
+     */
+    explicit BitGrid_C(const OccupancyGrid_C& grid, const bool transpose = false);
+
+    /**
+     * @brief number of rows
+     * @return number of rows
+     */
+    int64_t rows() const { return rows_; }
+
+    /**
+     * @brief number of columns
+     * @return number of columns
+     */
+    int64_t cols() const { return cols_; }
+
+    /**
+     * @brief checks whether a cell is blocked
+     * @param r - row
+     * @param c - column
+     * @return bool whether the cell is blocked or outside the grid
+     */
+    bool blocked(const int64_t r, const int64_t c) const
+    {
+        if (r < 0 || c < 0 || r >= rows_ || c >= cols_)
+        {
+            return true;
+        }
+        return (words_[r * wordsPerRow_ + (c >> 6)] >> (c & 63)) & 1U;
+    }
+
+    /**
+     * @brief extracts the occupancy of 64 consecutive cells of a row
+     * @param r - row
+     * @param start - first column
+     * @return word whose bit i is the occupancy of column start + i
+     */
+    uint64_t extract(const int64_t r, const int64_t start) const;
+
+private:
+    /** \brief number of rows */
+    int64_t rows_ = 0;
+    /** \brief number of columns */
+    int64_t cols_ = 0;
+    /** \brief number of words per row */
+    int64_t wordsPerRow_ = 0;
+    /** \brief row-major words, the bits past the last column are set */
+    std::vector<uint64_t> words_;
+};
+
+/** \brief first bytes of a map file */
+constexpr char map_file_magic[8] = {'D', 'L', 'P', 'E', 'M', 'A', 'P', '\0'};
+/** \brief version of the map file layout written by writeMapFile */
+constexpr uint16_t map_file_version = 1;
+/** \brief written in host byte order, a file written on a host of the other
+ * byte order reads it swapped and is refused */
+constexpr uint16_t map_file_byte_order = 0x0102;
+/** \brief alignment of the cells within a map file */
+constexpr uint64_t map_file_alignment = 64;
+
+/**
+ * @brief types the cells of a map file can have
+ */
+enum map_cell_type_E : uint32_t
+{
+    MAP_CELL_NONE = 0,
+    MAP_CELL_UINT8,
+    MAP_CELL_UINT16,
+    MAP_CELL_FLOAT,
+    MAP_CELL_DOUBLE,
+    MAP_CELL_LEN
+};
+
+/**
+ * @brief header at the start of a map file
+ * @details the header is followed, at dataOffset, by rows * cols cells of the
+ * given type in row-major order, exactly as Grid_C stores them. all fields are
+ * in host byte order.
+ */
+struct map_file_header_S
+{
+    /** \brief map_file_magic */
+    char magic[8];
+    /** \brief map_file_version */
+    uint16_t version;
+    /** \brief map_file_byte_order */
+    uint16_t byteOrder;
+    /** \brief type of the cells, map_cell_type_E */
+    uint32_t cellType;
+    /** \brief number of rows */
+    int64_t rows;
+    /** \brief number of columns */
+    int64_t cols;
+    /** \brief side of a cell in meters */
+    double resolution;
+    /** \brief offset of the first cell from the start of the file, a multiple of map_file_alignment */
+    uint64_t dataOffset;
+    /** \brief reserved, zero */
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(map_file_header_S) == 64, "map file header layout changed");
+
+/**
+ * @brief writes a grid as a map file
+ * @param fileName - path of the file, overwritten if it exists
+ * @param grid - grid to be written
+ * @param resolution - side of a cell in meters, stored in the header
+ * @return validity flag
+ * @details instantiated for uint8_t, uint16_t, float and double cells
+ */
+template <typename T>
+bool writeMapFile(const std::string& fileName, const Grid_C<T>& grid, const double resolution);
+
+/**
+ * @brief memory maps a map file as a grid
+ * @param fileName - path of the file
+ * @param resolution - receives the side of a cell in meters, may be null
+ * @return grid over the mapped cells, null if the file cannot be mapped or is
+ * not a valid map file with cells of type T
+ * @details nothing is read or copied: the cells are paged in from the page
+ * cache as the planners touch them, and processes mapping the same file share
+ * those pages. the file is unmapped once the last reference to the grid is
+ * gone, so a planner can be handed a new map while queries on the old one
+ * finish. the file must not be changed while it is mapped.
+ * instantiated for uint8_t, uint16_t, float and double cells
+ */
+template <typename T>
+std::shared_ptr<const Grid_C<T>> loadMapFile(const std::string& fileName, double* const resolution = nullptr);
+
+/** \brief first bytes of a landmark file */
+constexpr char landmark_file_magic[8] = {'D', 'L', 'P', 'E', 'L', 'M', 'K', '\0'};
+/** \brief version of the landmark file layout written by writeLandmarkFile */
+constexpr uint16_t landmark_file_version = 1;
+
+/**
+ * @brief header at the start of a landmark file
+ * @details the header is followed, at dataOffset, by a table of uint16_t
+ * distances with a row per cell of the map, in row-major order of the map,
+ * and a column per landmark. byte order and alignment are those of map files.
+ */
+struct landmark_file_header_S
+{
+    /** \brief landmark_file_magic */
+    char magic[8];
+    /** \brief landmark_file_version */
+    uint16_t version;
+    /** \brief map_file_byte_order */
+    uint16_t byteOrder;
+    /** \brief properties of the distances, defined by their user */
+    uint32_t flags;
+    /** \brief number of rows of the map */
+    int64_t rows;
+    /** \brief number of columns of the map */
+    int64_t cols;
+    /** \brief hashGrid() of the map the distances were computed on */
+    uint64_t mapHash;
+    /** \brief number of landmarks, columns of the table */
+    uint64_t numLandmarks;
+    /** \brief offset of the table from the start of the file, a multiple of map_file_alignment */
+    uint64_t dataOffset;
+    /** \brief reserved, zero */
+    uint8_t reserved[8];
+};
+
+static_assert(sizeof(landmark_file_header_S) == 64, "landmark file header layout changed");
+
+/**
+ * @brief writes a table of landmark distances as a landmark file
+ * @param fileName - path of the file, overwritten if it exists
+ * @param header - flags, rows, cols, mapHash and numLandmarks of the file,
+ * the other fields are filled in
+ * @param table - rows * cols rows of numLandmarks distances
+ * @return validity flag, false if the table does not match the header
+ */
+bool writeLandmarkFile(const std::string& fileName, landmark_file_header_S header, const Grid_C<uint16_t>& table);
+
+/**
+ * @brief memory maps a landmark file
+ * @param fileName - path of the file
+ * @param header - receives the header of the file
+ * @return table of distances over the mapped file, null if the file cannot be
+ * mapped or is not a valid landmark file
+ * @details as loadMapFile, nothing is read or copied and the file is unmapped
+ * once the last reference to the table is gone
+ */
+std::shared_ptr<const Grid_C<uint16_t>> loadLandmarkFile(const std::string& fileName, landmark_file_header_S& header);
 
 /**
  * @brief node class
@@ -154,7 +617,9 @@ public:
      * @return hash value
      */
     size_t operator () (const Node_C& n) const {
-        return std::hash<int64_t>()(n.x_) ^ std::hash<int64_t>()(n.y_);
+        /* combine instead of xor-ing, x ^ y collides along every diagonal */
+        const size_t hx = std::hash<int64_t>()(n.x_);
+        return hx ^ (std::hash<int64_t>()(n.y_) + 0x9e3779b97f4a7c15ULL + (hx << 6) + (hx >> 2));
     }
 };
 
@@ -210,11 +675,24 @@ struct compare_coord_S
 std::vector<Node_C> getPermissibleMotion();
 
 /**
-* @brief creates a random grid of a given size
+* @brief creates a reproducible random grid, every cell is an obstacle with
+* the given probability independently of the others
+* @param grid - referenct to grid
+* @param seed - seed of the generator, the same seed gives the same grid
+* @param density - probability of a cell being an obstacle, in [0, 1]
+* @return void
+*/
+void makeGrid(OccupancyGrid_C& grid, const uint32_t seed, const double density);
+
+/**
+* @brief creates a reproducible maze, corridors one cell wide between walls
+* one cell thick. cells with both coordinates even are always free and all free
+* cells are connected, with exactly one path between any two of them.
 * @param grid - referenct to grid
+* @param seed - seed of the generator, the same seed gives the same maze
 * @return void
 */
-void makeGrid(std::vector<std::vector<int64_t>>& grid);
+void makeMazeGrid(OccupancyGrid_C& grid, const uint32_t seed);
 
 /**
  * @brief compare coordinates between 2 nodes
@@ -227,10 +705,34 @@ bool compareCoordinates(const Node_C& p1, const Node_C& p2);
 /**
  * @brief checks whether the node is outside the boundary of the grid
  * @param node - node whose coordinates are to be checked
- * @param n - size of the grid
+ * @param rows - number of rows of the grid
+ * @param cols - number of columns of the grid
  * @return whether the node is outside the boundary of the grid
  */
-bool checkOutsideBoundary(const Node_C& node, const int64_t n);
+bool checkOutsideBoundary(const Node_C& node, const int64_t rows, const int64_t cols);
+
+/**
+ * @brief follows the parent ids of a path from the goal to the start
+ * @param pathVec - path vector, in any order
+ * @param start - start node
+ * @param goal - goal node
+ * @return indices in pathVec of the nodes from the goal towards the start,
+ * empty if the goal is not in pathVec. the walk stops at the start, at a node
+ * that is its own parent, or at a parent that is not in pathVec.
+ * @details the paths the planners return are ordered from goal to start, each
+ * parent is the next node and found in constant time; other parents are looked
+ * up by id in a table built once. linear in the size of pathVec.
+ */
+std::vector<size_t> tracePath(const std::vector<Node_C>& pathVec, const Node_C& start, const Node_C& goal);
+
+/**
+ * @brief spreads the costs of points over a grid of the map's size
+ * @param grid - grid the points are on
+ * @param pointVec - points, if several are on a cell the first one counts
+ * @return grid with the cost of the point on each cell, NaN on cells without
+ * a point. points outside the grid are left out.
+ */
+Grid_C<double> costLayer(const OccupancyGrid_C& grid, const std::vector<Node_C>& pointVec);
 
 /**
  * @brief struct to generate a hash for std::pair
@@ -353,6 +855,9 @@ class std::hash<node_key_pair_S> {
  * @brief the idea behind this class is to create a structure similar to a
  * priority queue that allows elements to be removed from the middle of the
  * queue as well, rather than just the top
+ * @details binary heap that tracks the position of every node (by coordinates),
+ * so each node is held once and insert (as update), remove and pop restore the
+ * heap in place in O(log n), without leaving stale entries behind.
  */
 class PrioQ_C
 {
@@ -365,7 +870,7 @@ public:
     void clear();
 
     /**
-     * @brief insert into the q
+     * @brief insert into the q, updates the key if the node is already in it
      * @return void
      */
     void insert(const node_key_pair_S& t);
@@ -407,15 +912,50 @@ public:
     void remove(const node_key_pair_S& t);
 
 private:
-  std::priority_queue<node_key_pair_S, std::vector<node_key_pair_S>, std::greater<node_key_pair_S>> pq;
-  // needs to just compare the coordinates and
-  std::unordered_set<node_key_pair_S, std::hash<node_key_pair_S>, compare_node_key_pair_coords_S> s;
+  /**
+   * @brief heap element, a node key pair with its position slot in pos
+   * @details the slot is written directly while sifting, so moving an element
+   * never needs a hash lookup
+   */
+  struct entry_S {
+      node_key_pair_S nkp;
+      size_t* slot;
+  };
+
+  // heap ordered by key, smallest on top
+  std::vector<entry_S> heap;
+  // position of each node in the heap, needs to just compare the coordinates
+  std::unordered_map<Node_C, size_t, std::hash<Node_C>, compare_coord_S> pos;
+
+  /**
+   * @brief moves an element into a heap slot and records its position
+   * @return void
+   */
+  void place(const size_t i, const entry_S& e);
+
+  /**
+   * @brief restores the heap order upwards from a slot
+   * @return void
+   */
+  void siftUp(size_t i);
+
+  /**
+   * @brief restores the heap order downwards from a slot
+   * @return void
+   */
+  void siftDown(size_t i);
+
+  /**
+   * @brief removes the element in a slot
+   * @return void
+   */
+  void removeAt(const size_t i);
 };
 
 template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value, T>::type>
-void printGrid(const std::vector<std::vector<T>>& grid)
+void printGrid(const Grid_C<T>& grid)
 {
-    int64_t n = grid.size();
+    int64_t n = grid.rows();
     std::cout << "Grid: " << '\n'
               << "-Points not considered ---> 0" << '\n'
               << "-Obstacles             ---> 1" << '\n'
@@ -432,10 +972,12 @@ void printGrid(const std::vector<std::vector<T>>& grid)
     }
     std::cout << '\n';
 
-    for (const auto& row : grid)
+    for (int64_t x = 0; x < grid.rows(); x++)
     {
-        for (const auto& ele : row)
+        for (int64_t y = 0; y < grid.cols(); y++)
         {
+            /* promote so that byte-sized cells print as numbers */
+            const auto ele = +grid(x, y);
             if (ele == 1)
             {
                 std::cout << RED << ele << RESET << " , ";
@@ -493,7 +1035,7 @@ void printNodeStatus(const Node_C& node);
 void printPath(const std::vector<Node_C>& pathVec,
                const Node_C& start,
                const Node_C& goal,
-               std::vector<std::vector<int64_t>>& grid);
+               OccupancyGrid_C& grid);
 
 /**
  * @brief prints the cost for reaching points on the grid in the grid shape
@@ -501,7 +1043,7 @@ void printPath(const std::vector<Node_C>& pathVec,
  * @param pointVec - vector of all points that have been considered. nodes in vector contain cost.
  * @return void
  */
-void printCost(const std::vector<std::vector<int64_t>>& grid,
+void printCost(const OccupancyGrid_C& grid,
                const std::vector<Node_C>& pointVec);
 
 /**
@@ -514,7 +1056,7 @@ void printCost(const std::vector<std::vector<int64_t>>& grid,
  * @return void
  */
 void printPathInOrder(const std::vector<Node_C>& pathVector, const Node_C& start,
-                      const Node_C& goal, std::vector<std::vector<int64_t>>& grid);
+                      const Node_C& goal, OccupancyGrid_C& grid);
 
 /* functions from logger utilities */
 
@@ -523,7 +1065,7 @@ struct data_logger_S
     /** @brief cycle count */
     uint64_t cycleNum;
     /** @brief grid */
-    std::vector<std::vector<int64_t>> grid;
+    OccupancyGrid_C grid;
     /** @brief path vector */
     std::vector<Node_C> pathVec;
     /** @brief point vector */
@@ -536,6 +1078,12 @@ struct data_logger_S
 
 /**
  * @brief logger class
+ * @details records are either handed over all at once and written with
+ * writeDataToFile(), or streamed: start() opens the file and a writer thread,
+ * log() moves each record into a bounded lock-free queue without waiting, and
+ * the writer thread formats the records into a large buffer that is written to
+ * the file as it fills up. stop(), or the destructor, writes what is left and
+ * joins the writer thread.
  */
 class Logger_C
 {
@@ -599,15 +1147,18 @@ public:
              const std::string& path);
 
     /**
-     * @brief default destructor for logger class
+     * @brief destructor for logger class, stops streaming if started
      */
-    ~Logger_C() {}
+    ~Logger_C() { stop(); }
+
+    Logger_C(const Logger_C&) = delete;
+    Logger_C& operator=(const Logger_C&) = delete;
 
     /**
      * @brief sets the data vector
-     * @param dataVec - data vector to be set
+     * @param dataVec - data vector to be set, moved from by the caller to avoid a copy
      */
-    void setDataVec(const std::vector<data_logger_S>& dataVec) { dataVec_ = dataVec; }
+    void setDataVec(std::vector<data_logger_S> dataVec) { dataVec_ = std::move(dataVec); }
 
     /**
      * @brief writes out the data to file
@@ -621,11 +1172,65 @@ public:
      */
     void setLogBitMap(const uint8_t bitMap);
 
+    /**
+     * @brief opens the file and starts the writer thread for log()
+     * @details the log bit map has to be set before
+     * @return validity flag, false if the file cannot be opened or streaming already started
+     */
+    bool start();
+
+    /**
+     * @brief queues a record for the writer thread, never waits
+     * @param data - record to be written, moved from if it was queued
+     * @return bool whether the record was queued, false if streaming was not
+     * started or the queue is full, in which case the record is dropped
+     */
+    bool log(data_logger_S&& data);
+
+    /**
+     * @brief writes the queued records and stops the writer thread
+     * @details log() may run concurrently: a record is either written or
+     * counted as dropped
+     * @return validity flag, false if a write failed or streaming was not started
+     */
+    bool stop();
+
+    /**
+     * @brief number of records log() dropped because the queue was full or
+     * streaming was stopped
+     * @return number of dropped records
+     */
+    uint64_t numDropped() const { return numDropped_.load(std::memory_order_relaxed); }
+
 private:
 
     /** \brief final file object */
     std::shared_ptr<std::ostream> p_fileToWrite_{ nullptr };
 
+    /** \brief buffer the writes to the file are gathered in */
+    std::unique_ptr<char[]> buffer_;
+
+    /** \brief records queued by log() for the writer thread */
+    BoundedQueue_C<data_logger_S> queue_{logger_queue_capacity};
+
+    /** \brief writer thread, runs between start() and stop() */
+    std::thread writer_;
+
+    /** \brief whether the writer thread is to keep waiting for records */
+    std::atomic<bool> streaming_{false};
+
+    /** \brief number of records log() dropped */
+    std::atomic<uint64_t> numDropped_{0};
+
+    /** \brief number of log() calls in progress, stop() waits for them */
+    std::atomic<uint32_t> numProducers_{0};
+
+    /** \brief guards the writer thread's wait for records */
+    std::mutex wakeMutex_;
+
+    /** \brief wakes the writer thread when records are queued or streaming stops */
+    std::condition_variable wake_;
+
     /** \brief final vector of data */
     std::vector<data_logger_S> dataVec_;
 
@@ -652,6 +1257,61 @@ private:
      */
     bool writeDataToTxt();
 
+    /**
+     * @brief opens the file with a large write buffer
+     * @return validity flag
+     */
+    bool openFile();
+
+    /**
+     * @brief writes the first lines of a text file
+     * @return void
+     */
+    void writeTxtHeader();
+
+    /**
+     * @brief writes one record to a text file
+     * @param data - record to be written, its grid is marked with the path
+     * @return void
+     */
+    void writeTxtRecord(data_logger_S& data);
+
+    /**
+     * @brief writes the header row of a csv file
+     * @return void
+     */
+    void writeCsvHeader();
+
+    /**
+     * @brief writes the rows of one record to a csv file
+     * @details the columns are [cycle,] record, index, x, y, cost, h_cost, id,
+     * parent_id, the cycle column only if cycles are enabled. rows, each if
+     * enabled in the log bit map:
+     *      - cycle: index is the number of path nodes, x and y the size of the
+     *        grid (if grids are enabled), cost the cost of the path.
+     *      - start, goal: the start and goal nodes.
+     *      - path, point: one row per node, index is its position in the vector.
+     * numbers are formatted with std::to_chars, doubles in the shortest form
+     * that reads back to the same value.
+     * @param data - record to be written
+     * @return void
+     */
+    void writeCsvRecord(const data_logger_S& data);
+
+    /**
+     * @brief writes one record in the layout of the extension
+     * @param data - record to be written
+     * @param extension - extension of the file
+     * @return void
+     */
+    void writeRecord(data_logger_S& data, const extension_E extension);
+
+    /**
+     * @brief body of the writer thread, writes queued records until stop()
+     * @return void
+     */
+    void writerLoop();
+
     /**
      * @brief writes data to comma seperated value file
      * @return validity flag
@@ -661,6 +1321,8 @@ private:
 
 /**
  * @brief function to update vector for logger data
+ * @details grid and vectors are moved into the new record, pass them with
+ * std::move() if they are not needed any more to avoid copying them
  * @param dataVec - vector to be updated
  * @param idx - index
  * @param grid - grid map
@@ -671,56 +1333,56 @@ private:
  */
 void updateDataVector(std::vector<data_logger_S>& dataVec,
                       const uint64_t idx,
-                      const std::vector<std::vector<int64_t>> grid,
-                      const std::vector<Node_C> pathVec,
-                      const std::vector<Node_C> pointVec,
+                      OccupancyGrid_C grid,
+                      std::vector<Node_C> pathVec,
+                      std::vector<Node_C> pointVec,
                       const Node_C startNode,
                       const Node_C goalNode);
 
 /**
  * @brief function to encapsulate logger class
  * @param logBitMap - bitmap of enabling loggers
- * @param dataVec - vector to be written
+ * @param dataVec - vector to be written, moved from by the caller to avoid a copy
  * @return validity flag
  */
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec);
+                  std::vector<data_logger_S> dataVec);
 
 /**
  * @brief overload function to encapsulate logger class
  * @param logBitMap - bitmap of enabling loggers
- * @param dataVec - vector to be written
+ * @param dataVec - vector to be written, moved from by the caller to avoid a copy
  * @param outExtension - output file extension
  * @return validity flag
  */
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension);
 
 /**
  * @brief overload function to encapsulate logger class
  * @param logBitMap - bitmap of enabling loggers
- * @param dataVec - vector to be written
+ * @param dataVec - vector to be written, moved from by the caller to avoid a copy
  * @param outExtension - output file extension
  * @param outName - output file name
  * @return validity flag
  */
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension,
                   const std::string& outName);
 
 /**
  * @brief function to encapsulate logger class
  * @param logBitMap - bitmap of enabling loggers
- * @param dataVec - vector to be written
+ * @param dataVec - vector to be written, moved from by the caller to avoid a copy
  * @param outExtension - output file extension
  * @param outName - output file name
  * @param outPath - output path
  * @return validity flag
  */
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension,
                   const std::string& outName,
                   const std::string& outPath);
@@ -728,19 +1390,19 @@ bool generateLogs(const uint8_t logBitMap,
 /**
  * @brief function to encapsulate logger class
  * @param logBitMap - bitmap of enabling loggers
- * @param dataVec - vector to be written
+ * @param dataVec - vector to be written, moved from by the caller to avoid a copy
  * @param logObj - logger class object
  * @return validity flag
  */
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   Logger_C& logObj);
 
 
 template<typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value, T>::type>
-void logGrid(std::shared_ptr<std::ostream> p_fileToWrite, const std::vector<std::vector<T>>& grid)
+void logGrid(std::shared_ptr<std::ostream> p_fileToWrite, const Grid_C<T>& grid)
 {
-    int64_t n = grid.size();
+    int64_t n = grid.rows();
     *p_fileToWrite << "Grid: " << '\n'
                    << "-Points not considered ---> 0" << '\n'
                    << "-Obstacles             ---> 1" << '\n'
@@ -757,10 +1419,12 @@ void logGrid(std::shared_ptr<std::ostream> p_fileToWrite, const std::vector<std:
     }
     *p_fileToWrite << '\n';
 
-    for (const auto& row : grid)
+    for (int64_t x = 0; x < grid.rows(); x++)
     {
-        for (const auto& ele : row)
+        for (int64_t y = 0; y < grid.cols(); y++)
         {
+            /* promote so that byte-sized cells log as numbers */
+            const auto ele = +grid(x, y);
             if (ele == 1)
             {
                 *p_fileToWrite << ele << " , ";
@@ -799,10 +1463,179 @@ void logGrid(std::shared_ptr<std::ostream> p_fileToWrite, const std::vector<std:
     *p_fileToWrite << '\n';
 }
 
+/* functions from trace utilities */
+
+/** \brief first bytes of a trace file */
+constexpr char trace_file_magic[8] = {'D', 'L', 'P', 'E', 'T', 'R', 'C', '\0'};
+/** \brief version of the trace file layout written by TraceWriter_C */
+constexpr uint16_t trace_file_version = 1;
+
+/**
+ * @brief kinds of records in a trace file, the first byte of every record
+ */
+enum trace_record_E : uint8_t
+{
+    TRACE_RECORD_NONE = 0,
+    TRACE_RECORD_GRID,
+    TRACE_RECORD_GRID_DIFF,
+    TRACE_RECORD_CYCLE,
+    TRACE_RECORD_LEN
+};
+
+/**
+ * @brief writes data_logger_S records to a compact binary trace file
+ * @details the file starts with a 16 byte header: trace_file_magic,
+ * trace_file_version and the log bit map, followed by records. all integers
+ * are LEB128 varints, signed ones zigzag encoded.
+ *      - TRACE_RECORD_GRID: rows, cols, then the cells as runs of (value byte, length).
+ *      - TRACE_RECORD_GRID_DIFF: id of the base grid, number of changed cells,
+ *        then (index gap to the previous changed cell, value byte) pairs.
+ *      - TRACE_RECORD_CYCLE: cycle number as a delta to the previous cycle, grid
+ *        id, a flags byte (bit 0: the points are the path), then start and goal,
+ *        the path and the points as node lists.
+ * grids get ids 0, 1, 2, ... in the order they are written. a record whose grid
+ * equals the last written one refers to it by id, one that differs in a few
+ * cells is written as a diff to it.
+ * a node list is the number of nodes, a flags byte, then the coordinates as
+ * deltas to the previous node. costs are varint deltas if all of them are
+ * integers (bit 0), heuristic costs are left out if all of them are 0 (bit 1),
+ * and ids are left out if every id is x * cols + y and every parent id is the
+ * id of the next node, the last node being its own parent (bit 2), as for the
+ * paths the planners return. otherwise they are stored in full.
+ * the records are gathered in a buffer that is written to the file when it
+ * reaches logger_buffer_size bytes.
+ */
+class TraceWriter_C
+{
+public:
+    /**
+     * @brief default constructor, no file is open
+     */
+    TraceWriter_C() = default;
+
+    /**
+     * @brief destructor, closes the file if open
+     */
+    ~TraceWriter_C() { close(); }
+
+    TraceWriter_C(const TraceWriter_C&) = delete;
+    TraceWriter_C& operator=(const TraceWriter_C&) = delete;
+
+    /**
+     * @brief creates the file and writes its header
+     * @param fileName - path of the file, overwritten if it exists
+     * @param logBitMap - bitmap of enabling loggers, kept for the decoder
+     * @return validity flag
+     */
+    bool open(const std::string& fileName, const uint8_t logBitMap);
+
+    /**
+     * @brief appends a record, and its grid if it was not written yet
+     * @param data - record to be written
+     * @return validity flag, false if no file is open
+     */
+    bool write(const data_logger_S& data);
+
+    /**
+     * @brief writes the buffered records and closes the file
+     * @return validity flag, false if a write failed or no file was open
+     */
+    bool close();
+
+private:
+    /** \brief file written to */
+    std::ofstream file_;
+    /** \brief records not written to the file yet */
+    std::vector<uint8_t> buffer_;
+    /** \brief last written grid, the base of the next diff */
+    OccupancyGrid_C lastGrid_;
+    /** \brief number of grids written, the id of the next one */
+    uint64_t numGrids_ = 0;
+    /** \brief cycle number of the last record */
+    uint64_t lastCycle_ = 0;
+
+    /**
+     * @brief writes the grid unless it equals the last one
+     * @param grid - grid of the record
+     * @return id of the grid
+     */
+    uint64_t writeGrid(const OccupancyGrid_C& grid);
+
+    /**
+     * @brief writes a node list
+     * @param nodes - nodes to be written
+     * @param cols - number of columns of the grid, to tell whether the ids can be left out
+     * @return void
+     */
+    void writeNodes(const std::vector<Node_C>& nodes, const int64_t cols);
+
+    /**
+     * @brief writes the buffer to the file once it is large enough
+     * @param force - write it whatever its size
+     * @return void
+     */
+    void flushBuffer(const bool force);
+};
+
+/**
+ * @brief reads the records of a trace file written by TraceWriter_C
+ */
+class TraceReader_C
+{
+public:
+    /**
+     * @brief opens the file and reads its header
+     * @param fileName - path of the file
+     * @return validity flag, false if the file cannot be read or is not a trace file
+     */
+    bool open(const std::string& fileName);
+
+    /**
+     * @brief log bit map the file was written with
+     * @return bitmap of enabling loggers
+     */
+    uint8_t logBitMap() const { return logBitMap_; }
+
+    /**
+     * @brief reads the next record
+     * @param data - receives the record, with a copy of its grid
+     * @return bool whether a record was read, false at the end of the file or
+     * if the file is corrupt
+     */
+    bool next(data_logger_S& data);
+
+private:
+    /** \brief file read from */
+    std::ifstream file_;
+    /** \brief log bit map from the header */
+    uint8_t logBitMap_ = 0;
+    /** \brief grids read so far, by id */
+    std::vector<OccupancyGrid_C> grids_;
+    /** \brief cycle number of the last record */
+    uint64_t lastCycle_ = 0;
+
+    /**
+     * @brief reads a varint
+     * @param value - receives the value
+     * @return validity flag
+     */
+    bool readVarint(uint64_t& value);
+
+    /**
+     * @brief reads a node list
+     * @param nodes - receives the nodes
+     * @param cols - number of columns of the grid, to derive left out ids
+     * @return validity flag
+     */
+    bool readNodes(std::vector<Node_C>& nodes, const int64_t cols);
+};
+
 /**
  * @brief handles filesystem
  * @details checks if path exists,
  * and if it doesn't and flag set to forcefully create directory, it creates it.
+ * a relative file name is taken relative to the directory of the executable.
+ * @param fileName - file name, set to the full path if the directory exists
  * @param forceDir - flag set to optionally force directory creation
  * @return if the directory exists
  */
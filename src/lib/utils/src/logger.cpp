@@ -4,6 +4,11 @@
  * @brief this is a file used for logging data into txt, csv, etc.
  */
 
+/* C/C++ standard includes */
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
 /* project-specific includes */
 #include "utils.hpp"
 
@@ -32,7 +37,7 @@ static void logPath(std::shared_ptr<std::ostream> p_fileToWrite,
                     const std::vector<Node_C>& pathVec,
                     const Node_C& start,
                     const Node_C& goal,
-                    std::vector<std::vector<int64_t>>& grid);
+                    OccupancyGrid_C& grid);
 
 /**
  * @brief logs the cost for reaching points on the grid in the grid shape
@@ -42,7 +47,7 @@ static void logPath(std::shared_ptr<std::ostream> p_fileToWrite,
  * @return void
  */
 static void logCost(std::shared_ptr<std::ostream> p_fileToWrite,
-                    const std::vector<std::vector<int64_t>>& grid,
+                    const OccupancyGrid_C& grid,
                     const std::vector<Node_C>& pointVec);
 
 /**
@@ -57,69 +62,60 @@ static void logCost(std::shared_ptr<std::ostream> p_fileToWrite,
  */
 static void logPathInOrder(std::shared_ptr<std::ostream> p_fileToWrite,
                            const std::vector<Node_C>& pathVec, const Node_C& start,
-                           const Node_C& goal, std::vector<std::vector<int64_t>>& grid);
+                           const Node_C& goal, OccupancyGrid_C& grid);
 
 
 void updateDataVector(std::vector<data_logger_S>& dataVec,
                       const uint64_t idx,
-                      const std::vector<std::vector<int64_t>> grid,
-                      const std::vector<Node_C> pathVec,
-                      const std::vector<Node_C> pointVec,
+                      OccupancyGrid_C grid,
+                      std::vector<Node_C> pathVec,
+                      std::vector<Node_C> pointVec,
                       const Node_C startNode,
                       const Node_C goalNode)
 {
-    data_logger_S tmpData {idx, grid, pathVec, pointVec, startNode, goalNode};
-    dataVec.push_back(tmpData);
+    dataVec.push_back({idx, std::move(grid), std::move(pathVec), std::move(pointVec), startNode, goalNode});
 }
 
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec)
+                  std::vector<data_logger_S> dataVec)
 {
-    bool valid;
     Logger_C logObj;
-    generateLogs(logBitMap, dataVec, logObj);
-    return true;
+    return generateLogs(logBitMap, std::move(dataVec), logObj);
 }
 
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension)
 {
-    bool valid;
     Logger_C logObj(outExtension);
-    generateLogs(logBitMap, dataVec, logObj);
-    return valid;
+    return generateLogs(logBitMap, std::move(dataVec), logObj);
 }
 
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension,
                   const std::string& outName)
 {
-    bool valid;
     Logger_C logObj(outExtension, outName);
-    generateLogs(logBitMap, dataVec, logObj);
-    return valid;
+    return generateLogs(logBitMap, std::move(dataVec), logObj);
 }
 
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   const std::string& outExtension,
                   const std::string& outName,
                   const std::string& outPath)
 {
-    bool valid;
-    Logger_C logObj(outPath, outName, outExtension);
-    generateLogs(logBitMap, dataVec, logObj);
-    return valid;
+    Logger_C logObj(outExtension, outName, outPath);
+    return generateLogs(logBitMap, std::move(dataVec), logObj);
 }
 
 bool generateLogs(const uint8_t logBitMap,
-                  const std::vector<data_logger_S>& dataVec,
+                  std::vector<data_logger_S> dataVec,
                   Logger_C& logObj)
 {
     bool valid;
-    logObj.setDataVec(dataVec);
+    logObj.setDataVec(std::move(dataVec));
     logObj.setLogBitMap(logBitMap);
     valid = logObj.writeDataToFile();
     return valid;
@@ -191,7 +187,115 @@ Logger_C::extension_E Logger_C::extractExtension() const
     return extExt;
 }
 
-bool Logger_C::writeDataToTxt()
+bool Logger_C::start()
+{
+    bool valid = !writer_.joinable() && EXTENSION_NON != extractExtension() && openFile();
+
+    if (valid)
+    {
+        if (EXTENSION_TXT == extractExtension())
+        {
+            writeTxtHeader();
+        }
+        else
+        {
+            writeCsvHeader();
+        }
+        numDropped_.store(0, std::memory_order_relaxed);
+        streaming_.store(true, std::memory_order_release);
+        writer_ = std::thread(&Logger_C::writerLoop, this);
+    }
+
+    return valid;
+}
+
+bool Logger_C::log(data_logger_S&& data)
+{
+    /* announced before streaming_ is read, so stop() either sees this call in
+     * flight or this call sees streaming_ cleared */
+    numProducers_.fetch_add(1, std::memory_order_seq_cst);
+    bool queued = streaming_.load(std::memory_order_seq_cst) && queue_.tryPush(std::move(data));
+    numProducers_.fetch_sub(1, std::memory_order_release);
+
+    if (queued)
+    {
+        wake_.notify_one();
+    }
+    else
+    {
+        numDropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return queued;
+}
+
+bool Logger_C::stop()
+{
+    bool valid = writer_.joinable();
+
+    if (valid)
+    {
+        {
+            /* under the lock, so the writer thread cannot miss the wake-up */
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            streaming_.store(false, std::memory_order_seq_cst);
+        }
+        wake_.notify_one();
+        /* a log() that saw streaming_ still set may not have pushed its record yet */
+        while (0 != numProducers_.load(std::memory_order_seq_cst))
+        {
+            std::this_thread::yield();
+        }
+        writer_.join();
+        /* records queued after the writer thread last found the queue empty */
+        const extension_E extension = extractExtension();
+        data_logger_S data;
+        while (queue_.tryPop(data))
+        {
+            writeRecord(data, extension);
+        }
+        p_fileToWrite_->flush();
+        valid = p_fileToWrite_->good();
+        p_fileToWrite_.reset();
+    }
+
+    return valid;
+}
+
+void Logger_C::writerLoop()
+{
+    const extension_E extension = extractExtension();
+    data_logger_S data;
+
+    for (;;)
+    {
+        while (queue_.tryPop(data))
+        {
+            writeRecord(data, extension);
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        if (!streaming_.load(std::memory_order_acquire))
+        {
+            break;
+        }
+        /* log() does not take the lock, a missed wake-up costs at most the timeout */
+        wake_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+}
+
+void Logger_C::writeRecord(data_logger_S& data, const extension_E extension)
+{
+    if (EXTENSION_TXT == extension)
+    {
+        writeTxtRecord(data);
+    }
+    else if (EXTENSION_CSV == extension)
+    {
+        writeCsvRecord(data);
+    }
+}
+
+bool Logger_C::openFile()
 {
     bool valid;
 
@@ -201,66 +305,86 @@ bool Logger_C::writeDataToTxt()
 
     if (valid)
     {
-        const std::string booleanArr[] = {"false", "true"};
-
         setFileName(newFileName);
 
-        p_fileToWrite_ = std::make_shared<std::ofstream>(fileName_);
+        if (!buffer_)
+        {
+            buffer_ = std::make_unique<char[]>(logger_buffer_size);
+        }
+        auto file = std::make_shared<std::ofstream>();
+        /* the buffer has to be set before the file is opened to take effect */
+        file->rdbuf()->pubsetbuf(buffer_.get(), logger_buffer_size);
+        file->open(fileName_);
+        valid = file->is_open();
+        p_fileToWrite_ = std::move(file);
+    }
 
-        *p_fileToWrite_ << "This is the first line of a generated file.\n";
-        *p_fileToWrite_ << "Options: "
-                        << "[ Cycle: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_CYCLE]]
-                            + " | Grid: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_GRID]]
-                            + " | Path: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_PATH]]
-                            + " | Point: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_POINT]]
-                            + " | Start: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_START]]
-                            + " | Goal: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_GOAL]]
-                            + " ]\n";
+    return valid;
+}
+
+void Logger_C::writeTxtHeader()
+{
+    const std::string booleanArr[] = {"false", "true"};
+
+    *p_fileToWrite_ << "This is the first line of a generated file.\n";
+    *p_fileToWrite_ << "Options: "
+                    << "[ Cycle: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_CYCLE]]
+                        + " | Grid: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_GRID]]
+                        + " | Path: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_PATH]]
+                        + " | Point: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_POINT]]
+                        + " | Start: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_START]]
+                        + " | Goal: " + booleanArr[a_bitMapEnableInVec_[DATA_LOGGER_GOAL]]
+                        + " ]\n";
+}
+
+void Logger_C::writeTxtRecord(data_logger_S& data)
+{
+    /* get each data element, iff it's set to true in bitmap */
+    if (a_bitMapEnableInVec_[DATA_LOGGER_CYCLE])
+    {
+        *p_fileToWrite_ << "\nCycle: " << data.cycleNum << "\n";
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_GRID])
+    {
+        *p_fileToWrite_ << "\nInitial Grid:\n";
+        logGrid(p_fileToWrite_, data.grid);
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_PATH]
+        && a_bitMapEnableInVec_[DATA_LOGGER_START]
+        && a_bitMapEnableInVec_[DATA_LOGGER_GOAL]
+        && a_bitMapEnableInVec_[DATA_LOGGER_GRID])
+    {
+        *p_fileToWrite_ << "\nPath:\n";
+        logPath(p_fileToWrite_, data.pathVec, data.startNode, data.goalNode, data.grid);
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_POINT]
+        && a_bitMapEnableInVec_[DATA_LOGGER_GRID])
+    {
+        *p_fileToWrite_ << "\nPoint:\n";
+        logCost(p_fileToWrite_, data.grid, data.pointVec);
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        *p_fileToWrite_ << std::setw(spacing_for_grid) << "----";
+    }
+    *p_fileToWrite_ << "\n";
+}
+
+bool Logger_C::writeDataToTxt()
+{
+    bool valid = !writer_.joinable() && openFile();
+
+    if (valid)
+    {
+        writeTxtHeader();
 
-        /* get each data element, iff it's set to true in bitmap */
         for (auto& elm : dataVec_)
         {
-            if (a_bitMapEnableInVec_[DATA_LOGGER_CYCLE])
-            {
-                *p_fileToWrite_ << "\nCycle: " << elm.cycleNum << "\n";
-            }
-            if (a_bitMapEnableInVec_[DATA_LOGGER_GRID])
-            {
-                *p_fileToWrite_ << "\nInitial Grid:\n";
-                logGrid(p_fileToWrite_, elm.grid);
-            }
-            if (a_bitMapEnableInVec_[DATA_LOGGER_PATH]
-                && a_bitMapEnableInVec_[DATA_LOGGER_START]
-                && a_bitMapEnableInVec_[DATA_LOGGER_GOAL]
-                && a_bitMapEnableInVec_[DATA_LOGGER_GRID])
-            {
-                *p_fileToWrite_ << "\nPath:\n";
-                logPath(p_fileToWrite_, elm.pathVec, elm.startNode, elm.goalNode, elm.grid);
-            }
-            if (a_bitMapEnableInVec_[DATA_LOGGER_POINT]
-                && a_bitMapEnableInVec_[DATA_LOGGER_GRID])
-            {
-                *p_fileToWrite_ << "\nPoint:\n";
-                logCost(p_fileToWrite_, elm.grid, elm.pointVec);
-            }
-            *p_fileToWrite_ << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << std::setw(spacing_for_grid) << "----"
-                            << "\n";
+            writeTxtRecord(elm);
         }
+        p_fileToWrite_->flush();
+        valid = p_fileToWrite_->good();
+        p_fileToWrite_.reset();
     }
 
     return valid;
@@ -268,11 +392,125 @@ bool Logger_C::writeDataToTxt()
 
 bool Logger_C::writeDataToCsv()
 {
-    bool valid = true;
+    bool valid = !writer_.joinable() && openFile();
+
+    if (valid)
+    {
+        writeCsvHeader();
+
+        for (auto& elm : dataVec_)
+        {
+            writeCsvRecord(elm);
+        }
+        p_fileToWrite_->flush();
+        valid = p_fileToWrite_->good();
+        p_fileToWrite_.reset();
+    }
 
     return valid;
 }
 
+void Logger_C::writeCsvHeader()
+{
+    if (a_bitMapEnableInVec_[DATA_LOGGER_CYCLE])
+    {
+        *p_fileToWrite_ << "cycle,";
+    }
+    *p_fileToWrite_ << "record,index,x,y,cost,h_cost,id,parent_id\n";
+}
+
+void Logger_C::writeCsvRecord(const data_logger_S& data)
+{
+    /* one row is at most 9 numbers of up to 24 characters, plus separators.
+     * each number is given its largest width, so nothing can pass the end */
+    char row[320];
+    const bool withCycle = a_bitMapEnableInVec_[DATA_LOGGER_CYCLE];
+
+    /* starts a row with the cycle column, if enabled, and the record name */
+    const auto begin = [&](const char* record, const size_t length) {
+        char* p = row;
+        if (withCycle)
+        {
+            p = std::to_chars(p, p + 20, data.cycleNum).ptr;
+            *p++ = ',';
+        }
+        std::memcpy(p, record, length);
+        return p + length;
+    };
+    const auto putInt = [](char* p, const int64_t value) {
+        p = std::to_chars(p, p + 20, value).ptr;
+        *p++ = ',';
+        return p;
+    };
+    const auto putDouble = [](char* p, const double value) {
+        p = std::to_chars(p, p + 24, value).ptr;
+        *p++ = ',';
+        return p;
+    };
+    /* writes a row for a node, index is its position in its vector */
+    const auto putNode = [&](const char* record, const size_t length, const int64_t index, const Node_C& node) {
+        char* p = begin(record, length);
+        p = putInt(p, index);
+        p = putInt(p, node.x_);
+        p = putInt(p, node.y_);
+        p = putDouble(p, node.cost_);
+        p = putDouble(p, node.hCost_);
+        p = putInt(p, node.id_);
+        p = putInt(p, node.pId_);
+        p[-1] = '\n';
+        p_fileToWrite_->write(row, p - row);
+    };
+
+    if (withCycle)
+    {
+        /* index: number of path nodes, x and y: grid size, cost: path cost */
+        char* p = begin("cycle,", 6);
+        p = putInt(p, static_cast<int64_t>(data.pathVec.size()));
+        if (a_bitMapEnableInVec_[DATA_LOGGER_GRID])
+        {
+            p = putInt(p, data.grid.rows());
+            p = putInt(p, data.grid.cols());
+        }
+        else
+        {
+            *p++ = ',';
+            *p++ = ',';
+        }
+        if (!data.pathVec.empty())
+        {
+            p = putDouble(p, data.pathVec.front().cost_);
+        }
+        else
+        {
+            *p++ = ',';
+        }
+        std::memcpy(p, ",,\n", 3);
+        p_fileToWrite_->write(row, p + 3 - row);
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_START])
+    {
+        putNode("start,", 6, 0, data.startNode);
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_GOAL])
+    {
+        putNode("goal,", 5, 0, data.goalNode);
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_PATH])
+    {
+        for (size_t i = 0; i < data.pathVec.size(); i++)
+        {
+            putNode("path,", 5, static_cast<int64_t>(i), data.pathVec[i]);
+        }
+    }
+    if (a_bitMapEnableInVec_[DATA_LOGGER_POINT])
+    {
+        for (size_t i = 0; i < data.pointVec.size(); i++)
+        {
+            putNode("point,", 6, static_cast<int64_t>(i), data.pointVec[i]);
+        }
+    }
+}
+
 static void logNodeStatus(std::shared_ptr<std::ostream> p_fileToWrite,
                           const Node_C& node)
 {
@@ -291,7 +529,7 @@ static void logPath(std::shared_ptr<std::ostream> p_fileToWrite,
                     const std::vector<Node_C>& pathVec,
                     const Node_C& start,
                     const Node_C& goal,
-                    std::vector<std::vector<int64_t>>& grid)
+                    OccupancyGrid_C& grid)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
     if (pathVec.empty())
@@ -301,57 +539,32 @@ static void logPath(std::shared_ptr<std::ostream> p_fileToWrite,
         return;
     }
     *p_fileToWrite << "Path (goal to start):" << '\n';
-    for (size_t i = 0; i < pathVec.size(); i++)
+    for (const size_t i : tracePath(pathVec, start, goal))
     {
-        if (compareCoordinates(goal, pathVec[i]))
-        {
-            logNodeStatus(p_fileToWrite, pathVec[i]);
-            grid[pathVec[i].x_][pathVec[i].y_] = 3;
-            while (pathVec[i].id_ != start.id_)
-            {
-                if (pathVec[i].id_ == pathVec[i].pId_)
-                {
-                    break;
-                }
-                for (size_t j = 0; j < pathVec.size(); j++)
-                {
-                    if (pathVec[i].pId_ == pathVec[j].id_)
-                    {
-                        i = j;
-                        logNodeStatus(p_fileToWrite, pathVec[j]);
-                        grid[pathVec[j].x_][pathVec[j].y_] = 3;
-                    }
-                }
-            }
-            break;
-        }
+        logNodeStatus(p_fileToWrite, pathVec[i]);
+        grid(pathVec[i].x_, pathVec[i].y_) = 3;
     }
-    grid[goal.x_][goal.y_] = 5;
-    grid[start.x_][start.y_] = 4;
+    grid(goal.x_, goal.y_) = 5;
+    grid(start.x_, start.y_) = 4;
     logGrid(p_fileToWrite, grid);
 #endif  // CUSTOM_DEBUG_HELPER_FUNCION
 }
 
 static void logCost(std::shared_ptr<std::ostream> p_fileToWrite,
-                    const std::vector<std::vector<int64_t>>& grid,
+                    const OccupancyGrid_C& grid,
                     const std::vector<Node_C>& pointVec)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
-    int64_t n = grid.size();
-    std::vector<Node_C>::const_iterator it_v;
-    for (int64_t i = 0; i < n; i++)
+    const Grid_C<double> layer = costLayer(grid, pointVec);
+    for (int64_t i = 0; i < layer.rows(); i++)
     {
-        for (int64_t j = 0; j < n; j++)
+        for (int64_t j = 0; j < layer.cols(); j++)
         {
-            for (it_v = pointVec.begin(); it_v != pointVec.end(); ++it_v)
+            if (!std::isnan(layer(i, j)))
             {
-                if (i == it_v->x_ && j == it_v->y_)
-                {
-                    *p_fileToWrite << std::setw(spacing_for_grid) << it_v->cost_ << " , ";
-                    break;
-                }
+                *p_fileToWrite << std::setw(spacing_for_grid) << layer(i, j) << " , ";
             }
-            if (it_v == pointVec.end())
+            else
             {
                 *p_fileToWrite << std::setw(spacing_for_grid) << "  , ";
             }
@@ -363,7 +576,7 @@ static void logCost(std::shared_ptr<std::ostream> p_fileToWrite,
 
 static void logPathInOrder(std::shared_ptr<std::ostream> p_fileToWrite,
                            const std::vector<Node_C>& pathVec, const Node_C& start,
-                           const Node_C& goal, std::vector<std::vector<int64_t>>& grid)
+                           const Node_C& goal, OccupancyGrid_C& grid)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
     if (pathVec.empty())
@@ -381,10 +594,10 @@ static void logPathInOrder(std::shared_ptr<std::ostream> p_fileToWrite,
     for (; i > 0; i = i - 1)
     {
         logNodeStatus(p_fileToWrite, pathVec[i]);
-        grid[pathVec[i].x_][pathVec[i].y_] = 3;
+        grid(pathVec[i].x_, pathVec[i].y_) = 3;
     }
     logNodeStatus(p_fileToWrite, pathVec[0]);
-    grid[pathVec[0].x_][pathVec[0].y_] = 3;
+    grid(pathVec[0].x_, pathVec[0].y_) = 3;
     logGrid(p_fileToWrite, grid);
 #endif  // CUSTOM_DEBUG_HELPER_FUNCION
 }
@@ -394,14 +607,20 @@ bool handleDirectory(std::string& fileName, const bool forceDir)
     bool exists;
     struct stat buf;
 
-    char result[PATH_MAX];
-    ssize_t count = readlink(LINUX_DIR_PROC, result, PATH_MAX);
+    /* relative names are relative to the directory of the executable */
     std::string path;
-    if (count != -1) {
-        path = static_cast<std::string>(dirname(result));
+    if (fileName.empty() || '/' != fileName.front())
+    {
+        char result[PATH_MAX];
+        ssize_t count = readlink(LINUX_DIR_PROC, result, PATH_MAX - 1);
+        if (count != -1) {
+            result[count] = '\0';
+            path = static_cast<std::string>(dirname(result));
+        }
+        path += "/";
     }
 
-    const std::string tmpFileDir = path + "/" + fileName.substr(0, fileName.find_last_of('/') + 1);
+    const std::string tmpFileDir = path + fileName.substr(0, fileName.find_last_of('/') + 1);
 
     exists  = (stat (tmpFileDir.c_str(), &buf) == 0);
 
@@ -417,13 +636,13 @@ bool handleDirectory(std::string& fileName, const bool forceDir)
             else
             {
                 exists = true;
-                fileName = path + "/" + fileName;
+                fileName = path + fileName;
             }
         }
     }
     else
     {
-        fileName = path + "/" + fileName;
+        fileName = path + fileName;
     }
 
     return exists;
@@ -0,0 +1,226 @@
+/**
+ * @file map_file.cpp
+ * @author osamy
+ * @brief this is a file used for writing and memory mapping binary map files
+ */
+
+/* system includes */
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/* project-specific includes */
+#include "utils.hpp"
+
+/* local functions */
+/**
+ * @brief map file code of a cell type
+ * @return cell type code, MAP_CELL_NONE for unsupported types
+ */
+template <typename T>
+static constexpr map_cell_type_E mapCellType()
+{
+    if constexpr (std::is_same_v<T, uint8_t>)
+    {
+        return MAP_CELL_UINT8;
+    }
+    else if constexpr (std::is_same_v<T, uint16_t>)
+    {
+        return MAP_CELL_UINT16;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        return MAP_CELL_FLOAT;
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return MAP_CELL_DOUBLE;
+    }
+    return MAP_CELL_NONE;
+}
+
+/**
+ * @brief an established memory mapping, unmapped when destroyed
+ */
+struct mapping_S
+{
+    /** \brief start of the mapping */
+    void* addr;
+    /** \brief length of the mapping in bytes */
+    size_t length;
+
+    mapping_S(void* const a, const size_t l) : addr(a), length(l) {}
+    mapping_S(const mapping_S&) = delete;
+    mapping_S& operator=(const mapping_S&) = delete;
+    ~mapping_S() { munmap(addr, length); }
+};
+
+/**
+ * @brief memory maps a whole file read-only
+ * @param fileName - path of the file
+ * @param minLength - smallest length of a valid file, in bytes
+ * @return mapping, null if the file cannot be mapped or is shorter than minLength
+ */
+static std::shared_ptr<mapping_S> mapFile(const std::string& fileName, const size_t minLength)
+{
+    const int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat buf;
+    if (0 != fstat(fd, &buf) || buf.st_size < static_cast<off_t>(minLength))
+    {
+        close(fd);
+        return nullptr;
+    }
+    const size_t length = static_cast<size_t>(buf.st_size);
+    /* read-only and shared: the pages come straight from the page cache */
+    void* const addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    /* the mapping stays valid once the descriptor is closed */
+    close(fd);
+    if (MAP_FAILED == addr)
+    {
+        return nullptr;
+    }
+    return std::make_shared<mapping_S>(addr, length);
+}
+
+/* function definitions */
+template <typename T>
+bool writeMapFile(const std::string& fileName, const Grid_C<T>& grid, const double resolution)
+{
+    static_assert(MAP_CELL_NONE != mapCellType<T>(), "unsupported map cell type");
+
+    map_file_header_S header{};
+    std::memcpy(header.magic, map_file_magic, sizeof(header.magic));
+    header.version = map_file_version;
+    header.byteOrder = map_file_byte_order;
+    header.cellType = mapCellType<T>();
+    header.rows = grid.rows();
+    header.cols = grid.cols();
+    header.resolution = resolution;
+    header.dataOffset = (sizeof(header) + map_file_alignment - 1) / map_file_alignment * map_file_alignment;
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const std::vector<char> padding(header.dataOffset - sizeof(header), 0);
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<const char*>(grid.data()),
+               static_cast<std::streamsize>(grid.numCells() * sizeof(T)));
+    file.close();
+    return !file.fail();
+}
+
+template <typename T>
+std::shared_ptr<const Grid_C<T>> loadMapFile(const std::string& fileName, double* const resolution)
+{
+    static_assert(MAP_CELL_NONE != mapCellType<T>(), "unsupported map cell type");
+
+    auto mapping = mapFile(fileName, sizeof(map_file_header_S));
+    if (!mapping)
+    {
+        return nullptr;
+    }
+    void* const addr = mapping->addr;
+    const size_t length = mapping->length;
+
+    map_file_header_S header;
+    std::memcpy(&header, addr, sizeof(header));
+    const bool valid = 0 == std::memcmp(header.magic, map_file_magic, sizeof(header.magic))
+                    && map_file_version == header.version
+                    && map_file_byte_order == header.byteOrder
+                    && mapCellType<T>() == header.cellType
+                    && header.rows >= 0 && header.cols >= 0
+                    && 0 == header.dataOffset % map_file_alignment
+                    && header.dataOffset >= sizeof(header)
+                    && header.dataOffset <= length
+                    && (0 == header.cols
+                        || static_cast<uint64_t>(header.rows)
+                               <= (length - header.dataOffset) / sizeof(T) / static_cast<uint64_t>(header.cols));
+    if (!valid)
+    {
+        return nullptr;
+    }
+    if (nullptr != resolution)
+    {
+        *resolution = header.resolution;
+    }
+    /* the grid is only handed out as const, the read-only pages are never written */
+    T* const cells = reinterpret_cast<T*>(static_cast<char*>(addr) + header.dataOffset);
+    return std::make_shared<const Grid_C<T>>(header.rows, header.cols, cells, std::move(mapping));
+}
+
+bool writeLandmarkFile(const std::string& fileName, landmark_file_header_S header, const Grid_C<uint16_t>& table)
+{
+    if (header.rows < 0 || header.cols < 0 || table.rows() != header.rows * header.cols
+        || table.cols() != static_cast<int64_t>(header.numLandmarks))
+    {
+        return false;
+    }
+    std::memcpy(header.magic, landmark_file_magic, sizeof(header.magic));
+    header.version = landmark_file_version;
+    header.byteOrder = map_file_byte_order;
+    header.dataOffset = (sizeof(header) + map_file_alignment - 1) / map_file_alignment * map_file_alignment;
+    std::memset(header.reserved, 0, sizeof(header.reserved));
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const std::vector<char> padding(header.dataOffset - sizeof(header), 0);
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<const char*>(table.data()),
+               static_cast<std::streamsize>(table.numCells() * sizeof(uint16_t)));
+    file.close();
+    return !file.fail();
+}
+
+std::shared_ptr<const Grid_C<uint16_t>> loadLandmarkFile(const std::string& fileName, landmark_file_header_S& header)
+{
+    auto mapping = mapFile(fileName, sizeof(landmark_file_header_S));
+    if (!mapping)
+    {
+        return nullptr;
+    }
+    const size_t length = mapping->length;
+
+    std::memcpy(&header, mapping->addr, sizeof(header));
+    /* rows * cols * numLandmarks distances must fit in the file, checked by
+     * division so that a corrupt header cannot overflow the product */
+    const uint64_t capacity = (length - std::min<uint64_t>(length, header.dataOffset)) / sizeof(uint16_t);
+    const bool valid = 0 == std::memcmp(header.magic, landmark_file_magic, sizeof(header.magic))
+                    && landmark_file_version == header.version
+                    && map_file_byte_order == header.byteOrder
+                    && header.rows >= 0 && header.cols >= 0
+                    && 0 == header.dataOffset % map_file_alignment
+                    && header.dataOffset >= sizeof(header)
+                    && header.dataOffset <= length
+                    && (0 == header.numLandmarks || 0 == header.cols
+                        || static_cast<uint64_t>(header.rows)
+                               <= capacity / header.numLandmarks / static_cast<uint64_t>(header.cols));
+    if (!valid)
+    {
+        return nullptr;
+    }
+    /* the table is only handed out as const, the read-only pages are never written */
+    uint16_t* const cells = reinterpret_cast<uint16_t*>(static_cast<char*>(mapping->addr) + header.dataOffset);
+    return std::make_shared<const Grid_C<uint16_t>>(header.rows * header.cols, static_cast<int64_t>(header.numLandmarks),
+                                                    cells, std::move(mapping));
+}
+
+template bool writeMapFile(const std::string&, const Grid_C<uint8_t>&, const double);
+template bool writeMapFile(const std::string&, const Grid_C<uint16_t>&, const double);
+template bool writeMapFile(const std::string&, const Grid_C<float>&, const double);
+template bool writeMapFile(const std::string&, const Grid_C<double>&, const double);
+
+template std::shared_ptr<const Grid_C<uint8_t>> loadMapFile(const std::string&, double* const);
+template std::shared_ptr<const Grid_C<uint16_t>> loadMapFile(const std::string&, double* const);
+template std::shared_ptr<const Grid_C<float>> loadMapFile(const std::string&, double* const);
+template std::shared_ptr<const Grid_C<double>> loadMapFile(const std::string&, double* const);
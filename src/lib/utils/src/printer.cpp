@@ -4,6 +4,9 @@
  * @brief this is a file to be used to print data
  */
 
+/* C/C++ standard includes */
+#include <cmath>
+
 /* project-specific includes */
 #include "utils.hpp"
 
@@ -22,7 +25,7 @@ void printNodeStatus(const Node_C& node)
 }
 
 void printPath(const std::vector<Node_C>& pathVec, const Node_C& start,
-               const Node_C& goal, std::vector<std::vector<int64_t>>& grid)
+               const Node_C& goal, OccupancyGrid_C& grid)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
     if (pathVec.empty())
@@ -32,56 +35,31 @@ void printPath(const std::vector<Node_C>& pathVec, const Node_C& start,
         return;
     }
     std::cout << "Path (goal to start):" << '\n';
-    for (size_t i = 0; i < pathVec.size(); i++)
+    for (const size_t i : tracePath(pathVec, start, goal))
     {
-        if (compareCoordinates(goal, pathVec[i]))
-        {
-            printNodeStatus(pathVec[i]);
-            grid[pathVec[i].x_][pathVec[i].y_] = 3;
-            while (pathVec[i].id_ != start.id_)
-            {
-                if (pathVec[i].id_ == pathVec[i].pId_)
-                {
-                    break;
-                }
-                for (size_t j = 0; j < pathVec.size(); j++)
-                {
-                    if (pathVec[i].pId_ == pathVec[j].id_)
-                    {
-                        i = j;
-                        printNodeStatus(pathVec[j]);
-                        grid[pathVec[j].x_][pathVec[j].y_] = 3;
-                    }
-                }
-            }
-            break;
-        }
+        printNodeStatus(pathVec[i]);
+        grid(pathVec[i].x_, pathVec[i].y_) = 3;
     }
-    grid[goal.x_][goal.y_] = 5;
-    grid[start.x_][start.y_] = 4;
+    grid(goal.x_, goal.y_) = 5;
+    grid(start.x_, start.y_) = 4;
     printGrid(grid);
 #endif  // CUSTOM_DEBUG_HELPER_FUNCION
 }
 
-void printCost(const std::vector<std::vector<int64_t>>& grid,
+void printCost(const OccupancyGrid_C& grid,
                const std::vector<Node_C>& pointVec)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
-    int64_t n = grid.size();
-    std::vector<Node_C>::const_iterator it_v;
-    for (int64_t i = 0; i < n; i++)
+    const Grid_C<double> layer = costLayer(grid, pointVec);
+    for (int64_t i = 0; i < layer.rows(); i++)
     {
-        for (int64_t j = 0; j < n; j++)
+        for (int64_t j = 0; j < layer.cols(); j++)
         {
-            for (it_v = pointVec.begin(); it_v != pointVec.end(); ++it_v)
+            if (!std::isnan(layer(i, j)))
             {
-                if (i == it_v->x_ && j == it_v->y_)
-                {
-                    std::cout << std::setw(spacing_for_grid) << it_v->cost_ << " , ";
-                    break;
-                }
+                std::cout << std::setw(spacing_for_grid) << layer(i, j) << " , ";
             }
-            if (it_v == pointVec.end())
+            else
             {
                 std::cout << std::setw(spacing_for_grid) << "  , ";
             }
@@ -93,7 +71,7 @@ void printCost(const std::vector<std::vector<int64_t>>& grid,
 
 void printPathInOrder(const std::vector<Node_C>& pathVec,
                       const Node_C& start, const Node_C& goal,
-                      std::vector<std::vector<int64_t>>& grid)
+                      OccupancyGrid_C& grid)
 {
 #ifdef CUSTOM_DEBUG_HELPER_FUNCION
     if (pathVec.empty())
@@ -111,10 +89,10 @@ void printPathInOrder(const std::vector<Node_C>& pathVec,
     for (; i > 0; i = i - 1)
     {
         printNodeStatus(pathVec[i]);
-        grid[pathVec[i].x_][pathVec[i].y_] = 3;
+        grid(pathVec[i].x_, pathVec[i].y_) = 3;
     }
     printNodeStatus(pathVec[0]);
-    grid[pathVec[0].x_][pathVec[0].y_] = 3;
+    grid(pathVec[0].x_, pathVec[0].y_) = 3;
     printGrid(grid);
 #endif  // CUSTOM_DEBUG_HELPER_FUNCION
 }
\ No newline at end of file
@@ -0,0 +1,476 @@
+/**
+ * @file trace.cpp
+ * @author osamy
+ * @brief this is a file used for writing and reading binary trace files
+ */
+
+/* system includes */
+#include <cmath>
+#include <cstring>
+
+/* project-specific includes */
+#include "utils.hpp"
+
+/* constants */
+/** \brief size of the trace file header in bytes */
+static constexpr size_t trace_header_size = 16;
+/** \brief largest integer a double holds exactly */
+static constexpr double max_exact_integer = 9007199254740992.0;
+
+/* local functions */
+/**
+ * @brief appends an unsigned LEB128 varint
+ * @param buffer - buffer to be appended to
+ * @param value - value to be written
+ * @return void
+ */
+static void putVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief appends a signed value as a zigzag varint
+ * @param buffer - buffer to be appended to
+ * @param value - value to be written
+ * @return void
+ */
+static void putSigned(std::vector<uint8_t>& buffer, const int64_t value)
+{
+    putVarint(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * @brief appends the 8 bytes of a double
+ * @param buffer - buffer to be appended to
+ * @param value - value to be written
+ * @return void
+ */
+static void putDouble(std::vector<uint8_t>& buffer, const double value)
+{
+    uint8_t bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(double));
+}
+
+/**
+ * @brief decodes a zigzag value
+ * @param value - zigzag encoded value
+ * @return signed value
+ */
+static int64_t unzigzag(const uint64_t value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+/**
+ * @brief checks whether two node lists are equal in every member
+ * @param a - first list
+ * @param b - second list
+ * @return bool whether the lists are equal
+ */
+static bool sameNodes(const std::vector<Node_C>& a, const std::vector<Node_C>& b)
+{
+    return a.size() == b.size()
+        && std::equal(a.begin(), a.end(), b.begin(), [](const Node_C& p, const Node_C& q) {
+               return p.x_ == q.x_ && p.y_ == q.y_ && p.cost_ == q.cost_ && p.hCost_ == q.hCost_
+                   && p.id_ == q.id_ && p.pId_ == q.pId_;
+           });
+}
+
+/* function definitions */
+bool TraceWriter_C::open(const std::string& fileName, const uint8_t logBitMap)
+{
+    close();
+    file_.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open())
+    {
+        return false;
+    }
+    buffer_.clear();
+    buffer_.reserve(logger_buffer_size + logger_buffer_size / 4);
+    buffer_.insert(buffer_.end(), trace_file_magic, trace_file_magic + sizeof(trace_file_magic));
+    buffer_.push_back(static_cast<uint8_t>(trace_file_version & 0xff));
+    buffer_.push_back(static_cast<uint8_t>(trace_file_version >> 8));
+    buffer_.push_back(logBitMap);
+    buffer_.resize(trace_header_size, 0);
+    numGrids_ = 0;
+    lastCycle_ = 0;
+    return true;
+}
+
+bool TraceWriter_C::write(const data_logger_S& data)
+{
+    if (!file_.is_open())
+    {
+        return false;
+    }
+    const uint64_t gridId = writeGrid(data.grid);
+    const bool pointsArePath = sameNodes(data.pointVec, data.pathVec);
+
+    buffer_.push_back(TRACE_RECORD_CYCLE);
+    putSigned(buffer_, static_cast<int64_t>(data.cycleNum - lastCycle_));
+    putVarint(buffer_, gridId);
+    buffer_.push_back(pointsArePath ? 1 : 0);
+    writeNodes({data.startNode, data.goalNode}, data.grid.cols());
+    writeNodes(data.pathVec, data.grid.cols());
+    if (!pointsArePath)
+    {
+        writeNodes(data.pointVec, data.grid.cols());
+    }
+    lastCycle_ = data.cycleNum;
+
+    flushBuffer(false);
+    return file_.good();
+}
+
+bool TraceWriter_C::close()
+{
+    bool valid = file_.is_open();
+
+    if (valid)
+    {
+        flushBuffer(true);
+        file_.close();
+        valid = !file_.fail();
+    }
+
+    return valid;
+}
+
+uint64_t TraceWriter_C::writeGrid(const OccupancyGrid_C& grid)
+{
+    const bool sameShape = numGrids_ > 0 && lastGrid_.rows() == grid.rows() && lastGrid_.cols() == grid.cols();
+    const int64_t numCells = grid.numCells();
+    const uint8_t* const cells = grid.data();
+    uint8_t* const last = lastGrid_.data();
+
+    int64_t numChanged = sameShape ? 0 : numCells;
+    for (int64_t i = 0; sameShape && i < numCells; i++)
+    {
+        numChanged += cells[i] != last[i];
+    }
+    if (sameShape && 0 == numChanged)
+    {
+        return numGrids_ - 1;
+    }
+
+    /* a changed cell costs 2 to 3 bytes as a diff, a run about as much in full */
+    if (sameShape && numChanged <= numCells / 16)
+    {
+        buffer_.push_back(TRACE_RECORD_GRID_DIFF);
+        putVarint(buffer_, numGrids_ - 1);
+        putVarint(buffer_, static_cast<uint64_t>(numChanged));
+        int64_t prev = 0;
+        for (int64_t i = 0; i < numCells; i++)
+        {
+            if (cells[i] != last[i])
+            {
+                putVarint(buffer_, static_cast<uint64_t>(i - prev));
+                buffer_.push_back(cells[i]);
+                last[i] = cells[i];
+                prev = i;
+            }
+        }
+    }
+    else
+    {
+        buffer_.push_back(TRACE_RECORD_GRID);
+        putVarint(buffer_, static_cast<uint64_t>(grid.rows()));
+        putVarint(buffer_, static_cast<uint64_t>(grid.cols()));
+        for (int64_t i = 0; i < numCells;)
+        {
+            int64_t end = i + 1;
+            while (end < numCells && cells[end] == cells[i])
+            {
+                end++;
+            }
+            buffer_.push_back(cells[i]);
+            putVarint(buffer_, static_cast<uint64_t>(end - i));
+            i = end;
+            flushBuffer(false);
+        }
+        if (sameShape)
+        {
+            std::copy(cells, cells + numCells, last);
+        }
+        else
+        {
+            lastGrid_ = grid;
+        }
+    }
+
+    return numGrids_++;
+}
+
+void TraceWriter_C::writeNodes(const std::vector<Node_C>& nodes, const int64_t cols)
+{
+    bool intCosts = true;
+    bool zeroHCosts = true;
+    bool derivedIds = true;
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        const Node_C& node = nodes[i];
+        const int64_t parentId = (i + 1 < nodes.size()) ? nodes[i + 1].id_ : node.id_;
+        intCosts = intCosts && std::fabs(node.cost_) < max_exact_integer && node.cost_ == std::trunc(node.cost_);
+        zeroHCosts = zeroHCosts && 0 == node.hCost_;
+        derivedIds = derivedIds && node.id_ == node.x_ * cols + node.y_ && node.pId_ == parentId;
+    }
+
+    putVarint(buffer_, nodes.size());
+    buffer_.push_back(static_cast<uint8_t>(intCosts | (zeroHCosts << 1) | (derivedIds << 2)));
+
+    Node_C prev;
+    for (const Node_C& node : nodes)
+    {
+        putSigned(buffer_, node.x_ - prev.x_);
+        putSigned(buffer_, node.y_ - prev.y_);
+        if (intCosts)
+        {
+            putSigned(buffer_, static_cast<int64_t>(node.cost_) - static_cast<int64_t>(prev.cost_));
+        }
+        else
+        {
+            putDouble(buffer_, node.cost_);
+        }
+        if (!zeroHCosts)
+        {
+            putDouble(buffer_, node.hCost_);
+        }
+        if (!derivedIds)
+        {
+            putSigned(buffer_, node.id_ - prev.id_);
+            putSigned(buffer_, node.pId_ - node.id_);
+        }
+        prev = node;
+    }
+}
+
+void TraceWriter_C::flushBuffer(const bool force)
+{
+    if (force || buffer_.size() >= logger_buffer_size)
+    {
+        file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+bool TraceReader_C::open(const std::string& fileName)
+{
+    file_.close();
+    file_.clear();
+    file_.open(fileName, std::ios::binary);
+    grids_.clear();
+    lastCycle_ = 0;
+
+    char header[trace_header_size];
+    bool valid = file_.is_open()
+              && trace_header_size == static_cast<size_t>(file_.rdbuf()->sgetn(header, trace_header_size))
+              && 0 == std::memcmp(header, trace_file_magic, sizeof(trace_file_magic))
+              && trace_file_version == (static_cast<uint8_t>(header[8]) | (static_cast<uint8_t>(header[9]) << 8));
+    logBitMap_ = valid ? static_cast<uint8_t>(header[10]) : 0;
+
+    return valid;
+}
+
+bool TraceReader_C::next(data_logger_S& data)
+{
+    std::streambuf* const in = file_.rdbuf();
+    if (!file_.is_open())
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        const int tag = in->sbumpc();
+        if (std::char_traits<char>::eof() == tag)
+        {
+            return false;
+        }
+
+        if (TRACE_RECORD_GRID == tag)
+        {
+            uint64_t rows;
+            uint64_t cols;
+            /* rejects sizes that cannot be a grid rather than trying to allocate them */
+            if (!readVarint(rows) || !readVarint(cols) || rows > (1u << 24) || cols > (1u << 24))
+            {
+                return false;
+            }
+            OccupancyGrid_C grid(static_cast<int64_t>(rows), static_cast<int64_t>(cols));
+            uint8_t* const cells = grid.data();
+            for (int64_t i = 0; i < grid.numCells();)
+            {
+                const int value = in->sbumpc();
+                uint64_t length;
+                if (std::char_traits<char>::eof() == value || !readVarint(length) || 0 == length
+                    || length > static_cast<uint64_t>(grid.numCells() - i))
+                {
+                    return false;
+                }
+                std::fill(cells + i, cells + i + length, static_cast<uint8_t>(value));
+                i += static_cast<int64_t>(length);
+            }
+            grids_.push_back(std::move(grid));
+        }
+        else if (TRACE_RECORD_GRID_DIFF == tag)
+        {
+            uint64_t baseId;
+            uint64_t numChanged;
+            if (!readVarint(baseId) || baseId >= grids_.size() || !readVarint(numChanged))
+            {
+                return false;
+            }
+            OccupancyGrid_C grid = grids_[baseId];
+            uint64_t idx = 0;
+            for (uint64_t k = 0; k < numChanged; k++)
+            {
+                uint64_t gap;
+                if (!readVarint(gap))
+                {
+                    return false;
+                }
+                idx += gap;
+                const int value = in->sbumpc();
+                if (std::char_traits<char>::eof() == value || idx >= static_cast<uint64_t>(grid.numCells()))
+                {
+                    return false;
+                }
+                grid[static_cast<int64_t>(idx)] = static_cast<uint8_t>(value);
+            }
+            grids_.push_back(std::move(grid));
+        }
+        else if (TRACE_RECORD_CYCLE == tag)
+        {
+            uint64_t cycleDelta;
+            uint64_t gridId;
+            if (!readVarint(cycleDelta) || !readVarint(gridId) || gridId >= grids_.size())
+            {
+                return false;
+            }
+            const int flags = in->sbumpc();
+            const int64_t cols = grids_[gridId].cols();
+            std::vector<Node_C> ends;
+            if (std::char_traits<char>::eof() == flags || !readNodes(ends, cols) || 2 != ends.size()
+                || !readNodes(data.pathVec, cols))
+            {
+                return false;
+            }
+            if (flags & 1)
+            {
+                data.pointVec = data.pathVec;
+            }
+            else if (!readNodes(data.pointVec, cols))
+            {
+                return false;
+            }
+            lastCycle_ += static_cast<uint64_t>(unzigzag(cycleDelta));
+            data.cycleNum = lastCycle_;
+            data.grid = grids_[gridId];
+            data.startNode = ends[0];
+            data.goalNode = ends[1];
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+}
+
+bool TraceReader_C::readVarint(uint64_t& value)
+{
+    std::streambuf* const in = file_.rdbuf();
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = in->sbumpc();
+        if (std::char_traits<char>::eof() == byte)
+        {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (0 == (byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TraceReader_C::readNodes(std::vector<Node_C>& nodes, const int64_t cols)
+{
+    std::streambuf* const in = file_.rdbuf();
+    uint64_t count;
+    if (!readVarint(count))
+    {
+        return false;
+    }
+    const int flags = in->sbumpc();
+    if (std::char_traits<char>::eof() == flags)
+    {
+        return false;
+    }
+    const bool intCosts = flags & 1;
+    const bool zeroHCosts = flags & 2;
+    const bool derivedIds = flags & 4;
+
+    nodes.clear();
+    Node_C prev;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t dx;
+        uint64_t dy;
+        if (!readVarint(dx) || !readVarint(dy))
+        {
+            return false;
+        }
+        Node_C node(prev.x_ + unzigzag(dx), prev.y_ + unzigzag(dy));
+        if (intCosts)
+        {
+            uint64_t dCost;
+            if (!readVarint(dCost))
+            {
+                return false;
+            }
+            node.cost_ = static_cast<double>(static_cast<int64_t>(prev.cost_) + unzigzag(dCost));
+        }
+        else if (sizeof(double) != in->sgetn(reinterpret_cast<char*>(&node.cost_), sizeof(double)))
+        {
+            return false;
+        }
+        if (!zeroHCosts && sizeof(double) != in->sgetn(reinterpret_cast<char*>(&node.hCost_), sizeof(double)))
+        {
+            return false;
+        }
+        if (derivedIds)
+        {
+            node.id_ = node.x_ * cols + node.y_;
+        }
+        else
+        {
+            uint64_t dId;
+            uint64_t dPId;
+            if (!readVarint(dId) || !readVarint(dPId))
+            {
+                return false;
+            }
+            node.id_ = prev.id_ + unzigzag(dId);
+            node.pId_ = node.id_ + unzigzag(dPId);
+        }
+        nodes.push_back(node);
+        prev = node;
+    }
+    /* derived parent ids are the ids of the next nodes */
+    for (size_t i = 0; derivedIds && i < nodes.size(); i++)
+    {
+        nodes[i].pId_ = (i + 1 < nodes.size()) ? nodes[i + 1].id_ : nodes[i].id_;
+    }
+    return true;
+}
@@ -5,6 +5,7 @@
  * for references see https://github.com/vss2sn/path_planning/blob/master/lib/utils/include/utils/utils.cpp
  */
 
+#include <cmath>
 #include <random>
 #include <stdint.h>
 
@@ -38,10 +39,69 @@ bool compareCoordinates(const Node_C& p1, const Node_C& p2)
 {
     return p1.x_ == p2.x_ && p1.y_ == p2.y_;
 }
-bool checkOutsideBoundary(const Node_C& node, const int64_t n)
+bool checkOutsideBoundary(const Node_C& node, const int64_t rows, const int64_t cols)
 {
     return (node.x_ < 0 || node.y_ < 0
-        || node.x_ >= n || node.y_ >= n);
+        || node.x_ >= rows || node.y_ >= cols);
+}
+
+std::vector<size_t> tracePath(const std::vector<Node_C>& pathVec, const Node_C& start, const Node_C& goal)
+{
+    std::vector<size_t> order;
+    size_t i = 0;
+    while (i < pathVec.size() && !compareCoordinates(goal, pathVec[i]))
+    {
+        i++;
+    }
+    if (i == pathVec.size())
+    {
+        return order;
+    }
+
+    /* index of the first node with each id, only built for unordered paths */
+    std::unordered_map<int64_t, size_t> byId;
+    order.push_back(i);
+    /* a path visits every node at most once, anything longer is a cycle */
+    while (pathVec[i].id_ != start.id_ && pathVec[i].id_ != pathVec[i].pId_ && order.size() < pathVec.size())
+    {
+        if (i + 1 < pathVec.size() && pathVec[i + 1].id_ == pathVec[i].pId_)
+        {
+            i++;
+        }
+        else
+        {
+            if (byId.empty())
+            {
+                byId.reserve(pathVec.size());
+                for (size_t j = 0; j < pathVec.size(); j++)
+                {
+                    byId.emplace(pathVec[j].id_, j);
+                }
+            }
+            const auto it = byId.find(pathVec[i].pId_);
+            if (it == byId.end())
+            {
+                break;
+            }
+            i = it->second;
+        }
+        order.push_back(i);
+    }
+    return order;
+}
+
+Grid_C<double> costLayer(const OccupancyGrid_C& grid, const std::vector<Node_C>& pointVec)
+{
+    Grid_C<double> layer(grid.rows(), grid.cols(), std::numeric_limits<double>::quiet_NaN());
+    for (const Node_C& point : pointVec)
+    {
+        if (point.x_ >= 0 && point.y_ >= 0 && point.x_ < grid.rows() && point.y_ < grid.cols()
+            && std::isnan(layer(point.x_, point.y_)))
+        {
+            layer(point.x_, point.y_) = point.cost_;
+        }
+    }
+    return layer;
 }
 
 bool compare_cost_S::operator()(const Node_C& p1, const Node_C& p2) const {
@@ -70,130 +130,234 @@ std::vector<Node_C> getPermissibleMotion()
         // Node_C(-1, 1, sqrt(2), 0, 0, 0),
         // Node_C(-1, -1, sqrt(2), 0, 0, 0)
     };
-    // NOTE: Add diagonal movements for A* and D* only after the heuristics in the
-    // algorithms have been modified. Refer to README.md. The heuristics currently
-    // implemented are based on Manhattan distance and dwill not account for
-    // diagonal/ any other motions
+    // NOTE: Add diagonal movements for D* only after the heuristics in the
+    // algorithm have been modified. Refer to README.md. The heuristic currently
+    // implemented is based on Manhattan distance and will not account for
+    // diagonal/ any other motions. A* takes its motions from grid_motion.hpp
 }
 
-void makeGrid(std::vector<std::vector<int64_t>>& grid)
+BitGrid_C::BitGrid_C(const OccupancyGrid_C& grid, const bool transpose)
+  : rows_(transpose ? grid.cols() : grid.rows()),
+    cols_(transpose ? grid.rows() : grid.cols()),
+    wordsPerRow_((cols_ + 63) / 64),
+    words_(static_cast<size_t>(rows_ * wordsPerRow_), 0)
 {
-    int64_t n = grid.size();
-    std::random_device rd;   // obtain a random number from hardware
-    std::mt19937 eng(rd());  // seed the generator
-    std::uniform_int_distribution<int64_t> distr(0, n);  // define the range
-
-    for (int64_t i = 0; i < n; i++)
+    for (int64_t r = 0; r < rows_; r++)
     {
-        for (int64_t j = 0; j < n; j++)
+        uint64_t* row = &words_[r * wordsPerRow_];
+        for (int64_t c = 0; c < cols_; c++)
+        {
+            const uint8_t cell = transpose ? grid(c, r) : grid(r, c);
+            if (0 != cell)
+            {
+                row[c >> 6] |= uint64_t{1} << (c & 63);
+            }
+        }
+        /* cells past the last column read as blocked */
+        if (0 != (cols_ & 63))
         {
-            grid[i][j] = distr(eng) / ((n - 1));  // probability of obstacle is 1/n
-            // grid[i][j] = 0; // For no obstacles
+            row[wordsPerRow_ - 1] |= ~uint64_t{0} << (cols_ & 63);
         }
     }
 }
 
-void PrioQ_C::clear()
+uint64_t BitGrid_C::extract(const int64_t r, const int64_t start) const
 {
-    s.clear();
-    while(!pq.empty())
+    if (r < 0 || r >= rows_ || start >= cols_ || start <= -64)
+    {
+        return ~uint64_t{0};
+    }
+    const uint64_t* row = &words_[r * wordsPerRow_];
+    const auto word = [&](const int64_t w) {
+        return (w < 0 || w >= wordsPerRow_) ? ~uint64_t{0} : row[w];
+    };
+    /* floor division, start may be negative */
+    const int64_t w = (start >= 0) ? (start >> 6) : -((-start + 63) >> 6);
+    const int64_t shift = start - w * 64;
+    if (0 == shift)
     {
-        pq.pop();
+        return word(w);
     }
+    return (word(w) >> shift) | (word(w + 1) << (64 - shift));
 }
 
-void PrioQ_C::insert(const node_key_pair_S& t)
+void makeGrid(OccupancyGrid_C& grid, const uint32_t seed, const double density)
 {
-    if (auto p = s.insert(t); !p.second)
+    std::mt19937 eng(seed);
+    std::bernoulli_distribution obstacle(density);
+
+    for (int64_t i = 0; i < grid.numCells(); i++)
     {
-        s.erase(t);
-        s.insert(t);
+        grid[i] = obstacle(eng) ? 1 : 0;
     }
-    pq.push(t);
 }
 
-void PrioQ_C::pop()
+void makeMazeGrid(OccupancyGrid_C& grid, const uint32_t seed)
 {
-    while(!pq.empty())
+    static constexpr int64_t steps[4][2] = {{-2, 0}, {2, 0}, {0, -2}, {0, 2}};
+    std::mt19937 eng(seed);
+    grid.fill(1);
+    if (grid.empty())
     {
-        if (const auto it = s.find(pq.top()); it == s.end() ||
-            (it != s.end() && pq.top().key != it->key))
+        return;
+    }
+
+    /* randomised depth first search over the cells with even coordinates,
+     * carving the wall between a cell and the neighbour it moves to */
+    std::vector<std::pair<int64_t, int64_t>> stack{{0, 0}};
+    grid(0, 0) = 0;
+    while (!stack.empty())
+    {
+        const auto [x, y] = stack.back();
+        int64_t open[4];
+        int numOpen = 0;
+        for (int s = 0; s < 4; s++)
         {
-            // Element been removed from set OR
-            // Element has been updated in set with new key, and inserted already into pq with new value
-            pq.pop();
+            const int64_t nx = x + steps[s][0];
+            const int64_t ny = y + steps[s][1];
+            if (nx >= 0 && ny >= 0 && nx < grid.rows() && ny < grid.cols() && 0 != grid(nx, ny))
+            {
+                open[numOpen++] = s;
+            }
         }
-        else if (it != s.end() && pq.top().key == it->key)
+        if (0 == numOpen)
         {
-            // Found an elelment that is in set and priority queue
-            break;
+            stack.pop_back();
+            continue;
         }
+        const int64_t s = open[std::uniform_int_distribution<int>(0, numOpen - 1)(eng)];
+        grid(x + steps[s][0] / 2, y + steps[s][1] / 2) = 0;
+        grid(x + steps[s][0], y + steps[s][1]) = 0;
+        stack.emplace_back(x + steps[s][0], y + steps[s][1]);
     }
-    if (s.empty())
-    {
-        return;
-    }
-    s.erase(pq.top());
-    pq.pop();
-    // The loop below allows top() to be const without making the
-    // std::priority_queue mutable
-    while(!pq.empty())
+}
+
+void PrioQ_C::clear()
+{
+    pos.clear();
+    heap.clear();
+}
+
+void PrioQ_C::insert(const node_key_pair_S& t)
+{
+    if (const auto [it, inserted] = pos.try_emplace(t.node, heap.size()); !inserted)
     {
-        if (const auto it = s.find(pq.top()); it == s.end() ||
-            (it != s.end() && pq.top().key != it->key))
+        // Already queued, update the key in place
+        const size_t i = it->second;
+        const bool decreased = t.key < heap[i].nkp.key;
+        heap[i].nkp = t;
+        if (decreased)
         {
-            // Element been removed from set OR
-            // Element has been updated in set with new key, and inserted already into pq with new value
-            pq.pop();
+            siftUp(i);
         }
-        else if (it != s.end() && pq.top().key == it->key)
+        else
         {
-            // Found an elelment that is in set and priority queue
-            break;
+            siftDown(i);
         }
     }
+    else
+    {
+        heap.push_back({t, &it->second});
+        siftUp(heap.size() - 1);
+    }
+}
+
+void PrioQ_C::pop()
+{
+    if (!heap.empty())
+    {
+        removeAt(0);
+    }
 }
 
 const node_key_pair_S& PrioQ_C::top() const
 {
-    return pq.top();
+    return heap.front().nkp;
 }
 
 size_t PrioQ_C::size() const
 {
-    return s.size();
+    return heap.size();
 }
 
 bool PrioQ_C::empty() const
 {
-    return s.empty();
+    return heap.empty();
 }
 
 bool PrioQ_C::isElementInStruct(const node_key_pair_S& t) const
 {
-    return s.find(t) != s.end();
+    return pos.find(t.node) != pos.end();
 }
 
 void PrioQ_C::remove(const node_key_pair_S& t)
 {
-    if (s.find(t) != s.end())
+    if (const auto it = pos.find(t.node); it != pos.end())
+    {
+        removeAt(it->second);
+    }
+}
+
+void PrioQ_C::place(const size_t i, const entry_S& e)
+{
+    heap[i] = e;
+    *e.slot = i;
+}
+
+void PrioQ_C::siftUp(size_t i)
+{
+    const entry_S e = heap[i];
+    while (i > 0)
     {
-        s.erase(t);
+        const size_t p = (i - 1) / 2;
+        if (!(e.nkp.key < heap[p].nkp.key))
+        {
+            break;
+        }
+        place(i, heap[p]);
+        i = p;
     }
-    // Ensure top() is const
-    while(!pq.empty())
+    place(i, e);
+}
+
+void PrioQ_C::siftDown(size_t i)
+{
+    const entry_S e = heap[i];
+    const size_t n = heap.size();
+    while (2 * i + 1 < n)
     {
-        if (const auto it = s.find(pq.top()); it == s.end() ||
-            (it != s.end() && pq.top().key != it->key))
+        size_t c = 2 * i + 1;
+        if (c + 1 < n && heap[c + 1].nkp.key < heap[c].nkp.key)
         {
-            // Element been removed from set OR
-            // Element has been updated in set with new key, and inserted already into pq with new value
-            pq.pop();
+            c++;
         }
-        else if (it != s.end() && pq.top().key == it->key)
+        if (!(heap[c].nkp.key < e.nkp.key))
         {
-            // Found an elelment that is in set and priority queue
             break;
         }
+        place(i, heap[c]);
+        i = c;
+    }
+    place(i, e);
+}
+
+void PrioQ_C::removeAt(const size_t i)
+{
+    pos.erase(heap[i].nkp.node);
+    const entry_S last = heap.back();
+    heap.pop_back();
+    if (i == heap.size())
+    {
+        return;
     }
-}
\ No newline at end of file
+    const bool decreased = last.nkp.key < heap[i].nkp.key;
+    place(i, last);
+    if (decreased)
+    {
+        siftUp(i);
+    }
+    else
+    {
+        siftDown(i);
+    }
+}
@@ -1,12 +1,21 @@
 /**
  * @file main.cpp
  * @author osamy
- * @brief int main() {}
+ * @brief int main(int argc, char* argv[]) {}
  */
 
+#include <cstdlib>
 #include <iostream>
 #include <random>
+#include <arastar.hpp>
 #include <astar.hpp>
+#include <biastar.hpp>
+#include <distance_field.hpp>
+#include <dstarlite.hpp>
+#include <hpa.hpp>
+#include <jps.hpp>
+#include <landmarks.hpp>
+#include <lpastar.hpp>
 
 /**
  * @brief execute the A* algorithm
@@ -18,9 +27,120 @@
  * @param grid - grid to work with
  * @return void
  */
-static void execAStar(Node_C& startNode, Node_C& goalNode, std::vector<std::vector<int64_t>>& grid);
+static void execAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
 
-static void execAStar(Node_C& startNode, Node_C& goalNode, std::vector<std::vector<int64_t>>& grid)
+/**
+ * @brief execute the 8-connected A* algorithm
+ * @details 1) create object for algorithm
+ *          2) run algorithm
+ *          3) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execAStar8(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the bidirectional A* algorithm
+ * @details 1) create object for algorithm
+ *          2) run algorithm
+ *          3) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execBiAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the D* Lite algorithm
+ * @details 1) create object for algorithm
+ *          2) set obstacles to be discovered on the way
+ *          3) run algorithm
+ *          4) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execDStarLite(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the hierarchical path-finding A* algorithm
+ * @details 1) create object for algorithm, which builds the abstract graph
+ *          2) run algorithm
+ *          3) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execHPA(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the jump point search algorithm
+ * @details 1) create object for algorithm
+ *          2) run algorithm
+ *          3) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execJPS(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the lifelong planning A* algorithm
+ * @details 1) create object for algorithm
+ *          2) run algorithm
+ *          3) block a cell of the path and run algorithm again
+ *          4) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execLPAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the one-to-all distance field algorithm
+ * @details 1) create object for algorithm
+ *          2) run algorithm, which sweeps the whole grid from the start
+ *          3) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execDistanceField(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the A* algorithm with the landmark (ALT) heuristic
+ * @details 1) pick landmarks on the grid and compute their distances
+ *          2) create object for algorithm and give it the landmarks
+ *          3) run algorithm
+ *          4) print the final grid using the pathVec
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execAStarLandmarks(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+/**
+ * @brief execute the anytime repairing A* (ARA*) algorithm
+ * @details 1) create object for algorithm and set its time budget
+ *          2) run algorithm, which improves its path until the budget runs out
+ *          3) print the final grid using the pathVec, and the bound of its cost
+ * @param startNode - start node
+ * @param goalNode - goal node
+ * @param grid - grid to work with
+ * @return void
+ */
+static void execARAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid);
+
+static void execAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
 {
 #ifdef ENABLE_PRINTER_DISPLAY
     std::cout << "algorithm: a*\n";
@@ -37,22 +157,163 @@ static void execAStar(Node_C& startNode, Node_C& goalNode, std::vector<std::vect
                                   | ENABLE_LOGGER_PATH
                                   | ENABLE_LOGGER_START | ENABLE_LOGGER_GOAL;
         updateDataVector(dataVec, 0, grid, pathVec, pathVec, startNode, goalNode);
-        generateLogs(logBitMap, dataVec);
+        generateLogs(logBitMap, std::move(dataVec));
 #endif /* ENABLE_LOGGER_DISPLAY */
     }
 }
 
+static void execAStar8(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: 8-connected a*\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::AStar8_C aStar(grid);
+    {
+        const auto [pathFound, pathVec] = aStar.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execBiAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: bidirectional a*\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::BiAStar_C biAStar(grid);
+    {
+        const auto [pathFound, pathVec] = biAStar.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execDStarLite(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: d* lite\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::DStarLite_C dStarLite(grid);
+    dStarLite.setDynamicObstacles(true);
+    {
+        const auto [pathFound, pathVec] = dStarLite.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        OccupancyGrid_C knownGrid = dStarLite.getKnownGrid();
+        printPath(pathVec, startNode, goalNode, knownGrid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execHPA(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: hpa*\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::HPA_C hpa(grid, 8);
+    {
+        const auto [pathFound, pathVec] = hpa.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execJPS(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: jps\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::JPS_C jps(grid);
+    {
+        const auto [pathFound, pathVec] = jps.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execLPAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: lpa*\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::LPAStar_C lpaStar(grid);
+    {
+        auto [pathFound, pathVec] = lpaStar.plan(startNode, goalNode);
+        if (pathVec.size() > 2)
+        {
+            /* block a cell in the middle of the path, the next query repairs the search */
+            const Node_C blocked = pathVec[pathVec.size() / 2];
+            lpaStar.updateCells({blocked}, 1);
+            grid(blocked.x_, blocked.y_) = 1;
+            std::tie(pathFound, pathVec) = lpaStar.plan(startNode, goalNode);
+        }
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execDistanceField(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: distance field\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::DistanceField_C distanceField(grid);
+    {
+        const auto [pathFound, pathVec] = distanceField.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execAStarLandmarks(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: a* with landmarks\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    const auto map = std::make_shared<const OccupancyGrid_C>(grid);
+    planning::AStar_C aStar(map);
+    aStar.setLandmarks(planning::Landmarks_C::build(map, 4));
+    {
+        const auto [pathFound, pathVec] = aStar.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
+static void execARAStar(Node_C& startNode, Node_C& goalNode, OccupancyGrid_C& grid)
+{
+#ifdef ENABLE_PRINTER_DISPLAY
+    std::cout << "algorithm: ara*\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    planning::ARAStar_C araStar(grid);
+    araStar.setBudget(std::chrono::milliseconds(1));
+    {
+        const auto [pathFound, pathVec] = araStar.plan(startNode, goalNode);
+#ifdef ENABLE_PRINTER_DISPLAY
+        printPath(pathVec, startNode, goalNode, grid);
+        std::cout << "suboptimality bound: " << araStar.getBound()
+                  << " after " << araStar.getNumSearches() << " searches\n";
+#endif /* ENABLE_PRINTER_DISPLAY */
+    }
+}
+
 #ifndef STANDALONE_BUILD
-int main() {
+int main(int argc, char* argv[]) {
 
     constexpr int64_t n = 33;
-    std::vector<std::vector<int64_t>> grid(n, std::vector<int64_t>(n, 0));
-    makeGrid(grid);
+    /* the same seed gives the same grid, start and goal; pass one to change them */
+    const uint32_t seed = (argc > 1) ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 42U;
+    OccupancyGrid_C grid(n, n, 0);
+    makeGrid(grid, seed, 2.0 / static_cast<double>(n + 1));
 
-    /* obtain a random number from hardware */
-    std::random_device rd;
     /* seed the generator */
-    std::mt19937 eng(rd());
+    std::mt19937 eng(seed);
     /* define the range */
     std::uniform_int_distribution<int> distr(0, n - 1);
 
@@ -64,20 +325,65 @@ int main() {
     goal.id_ = goal.x_ * n + goal.y_;
     start.hCost_ = abs(start.x_ - goal.x_) + abs(start.y_ - goal.y_);
     /* make sure start and goal are not obstacles and their ids are correctly assigned */
-    grid[start.x_][start.y_] = 0;
-    grid[goal.x_][goal.y_] = 0;
+    grid(start.x_, start.y_) = 0;
+    grid(goal.x_, goal.y_) = 0;
 #ifdef ENABLE_PRINTER_DISPLAY
     printGrid(grid);
 #endif /* ENABLE_PRINTER_DISPLAY */
 
     /* store point after algorithm's run */
-    std::vector<std::vector<int64_t>> mainGrid = grid;
+    OccupancyGrid_C mainGrid = grid;
 
     /* reset grid */
     grid = mainGrid;
     /* execute algorithm */
     execAStar(start, goal, grid);
 
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execAStar8(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execBiAStar(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execDStarLite(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execHPA(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execJPS(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execLPAStar(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execDistanceField(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execAStarLandmarks(start, goal, grid);
+
+    /* reset grid */
+    grid = mainGrid;
+    /* execute algorithm */
+    execARAStar(start, goal, grid);
+
     return 0;
 }
 #endif /* STANDALONE_BUILD */
\ No newline at end of file
@@ -12,10 +12,16 @@
  */
 #include <iostream>
 #include <stdint.h>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 
+#include "search_context.hpp"
+#include "search_stats.hpp"
+#include "thread_pool.hpp"
 #include "utils.hpp"
 
 namespace planning
@@ -23,8 +29,19 @@ namespace planning
 
 /**
  *  abstract class that is inherited by concerete implementaions of grid planner
- *  classes. the plan function is a pure virtual funciton that is overloaded
+ *  classes. the planInto function is a pure virtual funciton that is overloaded
  *  <TODO: wrap types and log into out files>
+ *  unless a planner's motion model says otherwise, moves go to the 4 edge
+ *  neighbours and entering a cell costs cellCost() of its value times the
+ *  length of the move; OccupancyGrid_C lists the planners that only tell free
+ *  cells from obstacles. maps may have any number of rows and columns, the id
+ *  of a node is row * columns + column. paths run from the goal to the start,
+ *  the cost of a node being its cost from the start. the start's own cost is
+ *  not counted, and it may be an obstacle, except for DStarLite_C, HPA_C and
+ *  JPS_C, which have no path from one.
+ *  planners that keep a copy of the map, most of them with a one cell obstacle
+ *  border so that neighbours need no bounds checks, change that copy in
+ *  updateCells(), never the shared map.
  */
 class GPEngine_C
 {
@@ -35,8 +52,17 @@ public:
      * @param grid the grid on which the planner is to plan
      * @return no return value
      */
-    GPEngine_C(std::vector<std::vector<int64_t>> grid)
-      : original_grid_(std::move(grid)), n_(original_grid_.size()){};
+    GPEngine_C(OccupancyGrid_C grid)
+      : GPEngine_C(std::make_shared<const OccupancyGrid_C>(std::move(grid))){};
+
+    /**
+     * @brief constructor
+     * @param map the map on which the planner is to plan, shared read-only
+     * between any number of planners
+     * @return no return value
+     */
+    GPEngine_C(std::shared_ptr<const OccupancyGrid_C> map)
+      : map_(std::move(map)), rows_(map_->rows()), cols_(map_->cols()){};
 
     /**
      * @brief copy constructor
@@ -74,12 +100,30 @@ public:
     virtual ~GPEngine_C() = default;
 
     /**
-     * @brief pure virtual function, overloaded by each of planners' implementations
+     * @brief answers a query
      * @param start - start node
      * @param goal - goal node
      * @return tuple containing bool, if there is a path, path
+     * @details goes through planInto() with a new path every time
      */
-    virtual std::tuple<bool, std::vector<Node_C>> plan(const Node_C& start, const Node_C& goal) = 0;
+    virtual std::tuple<bool, std::vector<Node_C>> plan(const Node_C& start, const Node_C& goal)
+    {
+        std::vector<Node_C> path;
+        const bool found = planInto(start, goal, path);
+        return {found, std::move(path)};
+    }
+
+    /**
+     * @brief pure virtual function, overloaded by each of planners' implementations
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details the path is cleared and refilled, so a vector that is reused
+     * between calls keeps its capacity, and most planners allocate nothing
+     * once their buffers have grown to the largest query so far.
+     */
+    virtual bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) = 0;
 
     /**
      * @brief sets the time discovered obstacles and flag to create random ones
@@ -97,10 +141,146 @@ public:
         std::cout << "Number of time discovered obstacles: " << timeDiscObst.size() << '\n';
     };
 
+    /**
+     * @brief changes cells of the map the planner plans on
+     * @param cells - cells to be changed, only their coordinates are used
+     * @param value - new value of the cells, see OccupancyGrid_C
+     * @return void
+     * @details for planners that keep derived data about the map and can
+     * update it in place. the shared map returned by getMap() is not changed.
+     */
+    virtual void updateCells(const std::vector<Node_C>& cells, const uint8_t value)
+    {
+        std::cout << "Please implement this function for the planner" << '\n';
+        std::cout << "Number of cells attempted to be changed: " << cells.size() << '\n';
+        std::cout << "Value attempted to be set: " << +value << '\n';
+    };
+
+    /**
+     * @brief answers a batch of queries on the shared map
+     * @param queries - start/goal pairs
+     * @param numThreads - number of threads, 0 to use one per hardware thread
+     * @param stats - if not null, receives the statistics of every query, in
+     * the order of the queries
+     * @return results of plan() for every query, in the order of the queries
+     * @details planners that can answer queries concurrently (see
+     * supportsConcurrentQueries) spread the queries over a thread pool that is
+     * kept between batches, each thread with its own search context. other
+     * planners answer the queries one after the other through plan().
+     * a planner must not run two batches at the same time.
+     */
+    std::vector<std::tuple<bool, std::vector<Node_C>>> planBatch(const std::vector<std::pair<Node_C, Node_C>>& queries,
+                                                                 size_t numThreads = 0,
+                                                                 std::vector<SearchStats_S>* stats = nullptr)
+    {
+        std::vector<std::tuple<bool, std::vector<Node_C>>> results(queries.size());
+        if (nullptr != stats)
+        {
+            stats->assign(queries.size(), SearchStats_S());
+        }
+        if (0 == numThreads)
+        {
+            numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        numThreads = std::min(numThreads, queries.size());
+
+        if (!supportsConcurrentQueries() || numThreads <= 1)
+        {
+            for (size_t i = 0; i < queries.size(); i++)
+            {
+                results[i] = plan(queries[i].first, queries[i].second);
+                if (nullptr != stats)
+                {
+                    (*stats)[i] = stats_;
+                }
+            }
+            return results;
+        }
+
+        if (batchCtx_.size() < numThreads)
+        {
+            batchCtx_.resize(numThreads);
+        }
+        workers(numThreads).parallelFor(queries.size(), [&](const size_t i, const size_t worker) {
+            auto& [found, path] = results[i];
+            found = planWithContext(queries[i].first, queries[i].second, batchCtx_[worker], path);
+            if (nullptr != stats)
+            {
+                (*stats)[i] = batchCtx_[worker].stats();
+            }
+        });
+        return results;
+    }
+
+    /**
+     * @brief returns the map the planner plans on
+     * @return shared pointer to the immutable map
+     * @details the pointer can be handed to other planners to share the map
+     */
+    std::shared_ptr<const OccupancyGrid_C> getMap() const { return map_; }
+
+    /**
+     * @brief returns the statistics of the last call to plan()
+     * @return const reference to the statistics
+     * @details only recorded when built with ENABLE_PLANNER_STATS, see SearchStats_S
+     */
+    const SearchStats_S& getStats() const { return stats_; }
+
 protected:
-    std::vector<std::vector<int64_t>> grid_ = {};
-    const std::vector<std::vector<int64_t>> original_grid_;
-    const int64_t n_;
+    /** \brief immutable map, never written to while planning */
+    std::shared_ptr<const OccupancyGrid_C> map_;
+    /** \brief number of rows of the map */
+    const int64_t rows_;
+    /** \brief number of columns of the map, the stride of cell ids */
+    const int64_t cols_;
+    /** \brief statistics of the last call to plan() */
+    SearchStats_S stats_;
+
+    /**
+     * @brief workers of planBatch, also there for the planners' own parallel work
+     * @param numThreads - number of workers
+     * @return the pool, created on first use and again only when numThreads changes
+     */
+    ThreadPool_C& workers(const size_t numThreads)
+    {
+        if (!pool_ || pool_->size() != numThreads)
+        {
+            pool_ = std::make_shared<ThreadPool_C>(numThreads);
+        }
+        return *pool_;
+    }
+
+    /**
+     * @brief whether planWithContext is implemented and safe to call concurrently
+     * @return bool, false unless overridden
+     */
+    virtual bool supportsConcurrentQueries() const { return false; }
+
+    /**
+     * @brief answers a query using only the given context as scratch state
+     * @param start - start node
+     * @param goal - goal node
+     * @param ctx - per-thread search context
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details must not modify the planner, so that several threads can call it
+     * at once with their own contexts
+     */
+    virtual bool planWithContext(const Node_C& start, const Node_C& goal, SearchContext_C& ctx,
+                                 std::vector<Node_C>& path) const
+    {
+        (void)start;
+        (void)goal;
+        (void)ctx;
+        path.clear();
+        return false;
+    }
+
+private:
+    /** \brief workers of planBatch and of the planners, see workers() */
+    std::shared_ptr<ThreadPool_C> pool_;
+    /** \brief one search context per worker of planBatch */
+    std::vector<SearchContext_C> batchCtx_;
 };
 
 } // namespace planning
@@ -0,0 +1,127 @@
+/**
+ * @file grid_motion.hpp
+ * @author osamy
+ * @brief motion models, heuristics and cell costs of the grid planners
+ */
+
+#ifndef GRID_MOTION_H_
+#define GRID_MOTION_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace planning
+{
+
+/**
+ * @brief cost of entering a cell, read from the value stored in the grid
+ * @param v - value of the cell
+ * @return 1 for a free cell (0), infinity for an obstacle (1), v for any other
+ * value, so weighted cells cost at least 2
+ * @details every cell costs at least 1, so heuristics that assume unit costs
+ * stay admissible on weighted grids.
+ */
+template <typename Cell_T>
+constexpr double cellCost(const Cell_T v)
+{
+    return (0 == v) ? 1.0 : ((1 == v) ? std::numeric_limits<double>::infinity() : static_cast<double>(v));
+}
+
+/**
+ * @brief checks whether a cell can be entered at all
+ * @param v - value of the cell
+ * @return bool whether the cell is not an obstacle
+ */
+template <typename Cell_T>
+constexpr bool isTraversable(const Cell_T v)
+{
+    return 1 != v;
+}
+
+/**
+ * @brief moves to the 4 edge neighbours, each of length 1
+ */
+struct FourConnected_S
+{
+    static constexpr int connectivity = 4;
+    static constexpr int64_t dx[connectivity] = {0, 1, 0, -1};
+    static constexpr int64_t dy[connectivity] = {1, 0, -1, 0};
+    static constexpr double length[connectivity] = {1, 1, 1, 1};
+};
+
+/**
+ * @brief moves to the 8 edge and corner neighbours, diagonal moves of length
+ * sqrt(2). a diagonal move is only allowed when both cells it passes between
+ * can be entered, so paths never cut corners.
+ */
+struct EightConnected_S
+{
+    static constexpr int connectivity = 8;
+    static constexpr int64_t dx[connectivity] = {0, 1, 0, -1, 1, 1, -1, -1};
+    static constexpr int64_t dy[connectivity] = {1, 0, -1, 0, 1, -1, 1, -1};
+    static constexpr double length[connectivity] = {1, 1, 1, 1, M_SQRT2, M_SQRT2, M_SQRT2, M_SQRT2};
+};
+
+/**
+ * @brief manhattan distance, admissible for up to 4-connected motion
+ */
+struct Manhattan_S
+{
+    /** \brief largest connectivity the heuristic is admissible for */
+    static constexpr int maxConnectivity = 4;
+
+    /**
+     * @brief estimated cost of a displacement
+     * @param dx - row difference
+     * @param dy - column difference
+     * @return |dx| + |dy|
+     */
+    double operator()(const int64_t dx, const int64_t dy) const
+    {
+        return static_cast<double>(std::abs(dx) + std::abs(dy));
+    }
+};
+
+/**
+ * @brief octile distance, admissible for up to 8-connected motion
+ */
+struct Octile_S
+{
+    /** \brief largest connectivity the heuristic is admissible for */
+    static constexpr int maxConnectivity = 8;
+
+    /**
+     * @brief estimated cost of a displacement
+     * @param dx - row difference
+     * @param dy - column difference
+     * @return cost of the cheapest 8-connected move sequence on an empty grid
+     */
+    double operator()(const int64_t dx, const int64_t dy) const
+    {
+        const int64_t ax = std::abs(dx);
+        const int64_t ay = std::abs(dy);
+        return static_cast<double>(ax + ay) + (M_SQRT2 - 2.0) * static_cast<double>(std::min(ax, ay));
+    }
+};
+
+/**
+ * @brief no estimate at all, turns A* into Dijkstra's algorithm
+ */
+struct Zero_S
+{
+    /** \brief largest connectivity the heuristic is admissible for */
+    static constexpr int maxConnectivity = 8;
+
+    /**
+     * @brief estimated cost of a displacement
+     * @return 0
+     */
+    double operator()(const int64_t, const int64_t) const { return 0; }
+};
+
+} // namespace planning
+
+#endif /* GRID_MOTION_H_ */
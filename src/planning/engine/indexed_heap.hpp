@@ -0,0 +1,312 @@
+/**
+ * @file indexed_heap.hpp
+ * @author osamy
+ * @brief d-ary min-heap over integer ids with decrease-key
+ */
+
+#ifndef INDEXED_HEAP_H_
+#define INDEXED_HEAP_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits>
+#include <vector>
+
+namespace planning
+{
+
+/**
+ * @brief d-ary min-heap whose elements are ids in [0, capacity) with a key each
+ * @details the position of every id in the heap is tracked, so an id is held at
+ * most once and its key can be updated or the id removed in O(log n) in place.
+ * ids are cell indices for the grid planners, keys are compared with operator<.
+ * a 4-ary heap is used by default: it is shallower than a binary heap and the
+ * children of a node share a cache line.
+ */
+template <typename Key_T, size_t D = 4>
+class IndexedHeap_C
+{
+    static_assert(D >= 2, "heap arity must be at least 2");
+
+public:
+    /**
+     * @brief makes room for ids in [0, capacity)
+     * @param capacity - number of ids
+     * @return void
+     * @details only ever grows, ids already in the heap are kept. the heap
+     * holds every id at most once, so room for capacity elements is reserved
+     * as well and no push allocates afterwards
+     */
+    void resize(const int64_t capacity)
+    {
+        if (static_cast<int64_t>(pos_.size()) < capacity)
+        {
+            pos_.resize(capacity, npos);
+            heap_.reserve(static_cast<size_t>(capacity));
+        }
+    }
+
+    /**
+     * @brief removes every element
+     * @return void
+     * @details costs O(size), not O(capacity)
+     */
+    void clear()
+    {
+        for (const auto& e : heap_)
+        {
+            pos_[e.id] = npos;
+        }
+        heap_.clear();
+    }
+
+    /**
+     * @brief checks whether the heap is empty
+     * @return bool whether the heap is empty
+     */
+    bool empty() const { return heap_.empty(); }
+
+    /**
+     * @brief number of elements in the heap
+     * @return number of elements
+     */
+    size_t size() const { return heap_.size(); }
+
+    /**
+     * @brief checks whether an id is in the heap
+     * @param id - id to be checked
+     * @return bool whether the id is in the heap
+     */
+    bool contains(const int64_t id) const { return pos_[id] != npos; }
+
+    /**
+     * @brief id with the smallest key
+     * @return id at the top of the heap
+     */
+    int64_t top() const { return heap_.front().id; }
+
+    /**
+     * @brief smallest key
+     * @return key of the element at the top of the heap
+     */
+    const Key_T& topKey() const { return heap_.front().key; }
+
+    /**
+     * @brief key of an id in the heap
+     * @param id - id whose key is requested, must be in the heap
+     * @return key of the id
+     */
+    const Key_T& key(const int64_t id) const { return heap_[pos_[id]].key; }
+
+    /**
+     * @brief inserts an id, or updates its key if it is already in the heap
+     * @param id - id to be inserted
+     * @param key - key of the id
+     * @return void
+     */
+    void push(const int64_t id, const Key_T& key)
+    {
+        if (contains(id))
+        {
+            update(id, key);
+            return;
+        }
+        heap_.push_back({key, static_cast<uint32_t>(id)});
+        pos_[id] = static_cast<uint32_t>(heap_.size() - 1);
+        siftUp(heap_.size() - 1);
+    }
+
+    /**
+     * @brief changes the key of an id in the heap, in either direction
+     * @param id - id to be updated, must be in the heap
+     * @param key - new key
+     * @return void
+     */
+    void update(const int64_t id, const Key_T& key)
+    {
+        const size_t i = pos_[id];
+        const bool decreased = key < heap_[i].key;
+        heap_[i].key = key;
+        if (decreased)
+        {
+            siftUp(i);
+        }
+        else
+        {
+            siftDown(i);
+        }
+    }
+
+    /**
+     * @brief recomputes the key of every element and restores the heap order
+     * @param keyOf - functor returning the new key of an id
+     * @return void
+     * @details O(size), for when every key changes at once
+     */
+    template <typename KeyOf_T>
+    void rekey(KeyOf_T keyOf)
+    {
+        for (auto& e : heap_)
+        {
+            e.key = keyOf(static_cast<int64_t>(e.id));
+        }
+        for (size_t i = heap_.size() / D + 1; i-- > 0;)
+        {
+            if (i < heap_.size())
+            {
+                siftDown(i);
+            }
+        }
+    }
+
+    /**
+     * @brief calls a functor on every element, in no particular order
+     * @param f - functor taking the id and the key of an element
+     * @return void
+     */
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (const auto& e : heap_)
+        {
+            f(static_cast<int64_t>(e.id), e.key);
+        }
+    }
+
+    /**
+     * @brief removes the element with the smallest key
+     * @return void
+     */
+    void pop() { removeAt(0); }
+
+    /**
+     * @brief removes an id from the heap if it is in it
+     * @param id - id to be removed
+     * @return void
+     */
+    void remove(const int64_t id)
+    {
+        if (contains(id))
+        {
+            removeAt(pos_[id]);
+        }
+    }
+
+private:
+    /**
+     * @brief element of the heap
+     */
+    struct entry_S
+    {
+        /** \brief key */
+        Key_T key;
+        /** \brief id */
+        uint32_t id;
+    };
+
+    /** \brief position of ids that are not in the heap */
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    /** \brief heap ordered array */
+    std::vector<entry_S> heap_;
+    /** \brief position of each id in heap_, npos if absent */
+    std::vector<uint32_t> pos_;
+
+    /**
+     * @brief places an element at a position and records it
+     * @param i - position in the heap
+     * @param e - element to be placed
+     * @return void
+     */
+    void place(const size_t i, const entry_S& e)
+    {
+        heap_[i] = e;
+        pos_[e.id] = static_cast<uint32_t>(i);
+    }
+
+    /**
+     * @brief removes the element at a position
+     * @param i - position in the heap
+     * @return void
+     */
+    void removeAt(const size_t i)
+    {
+        pos_[heap_[i].id] = npos;
+        const entry_S last = heap_.back();
+        heap_.pop_back();
+        if (i == heap_.size())
+        {
+            return;
+        }
+        const bool decreased = last.key < heap_[i].key;
+        place(i, last);
+        if (decreased)
+        {
+            siftUp(i);
+        }
+        else
+        {
+            siftDown(i);
+        }
+    }
+
+    /**
+     * @brief restores the heap order upwards from a position
+     * @param i - position in the heap
+     * @return void
+     */
+    void siftUp(size_t i)
+    {
+        const entry_S e = heap_[i];
+        while (i > 0)
+        {
+            const size_t p = (i - 1) / D;
+            if (!(e.key < heap_[p].key))
+            {
+                break;
+            }
+            place(i, heap_[p]);
+            i = p;
+        }
+        place(i, e);
+    }
+
+    /**
+     * @brief restores the heap order downwards from a position
+     * @param i - position in the heap
+     * @return void
+     */
+    void siftDown(size_t i)
+    {
+        const entry_S e = heap_[i];
+        const size_t n = heap_.size();
+        while (true)
+        {
+            const size_t first = i * D + 1;
+            if (first >= n)
+            {
+                break;
+            }
+            const size_t last = (first + D < n) ? first + D : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; c++)
+            {
+                if (heap_[c].key < heap_[best].key)
+                {
+                    best = c;
+                }
+            }
+            if (!(heap_[best].key < e.key))
+            {
+                break;
+            }
+            place(i, heap_[best]);
+            i = best;
+        }
+        place(i, e);
+    }
+};
+
+} // namespace planning
+
+#endif /* INDEXED_HEAP_H_ */
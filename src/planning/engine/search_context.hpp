@@ -0,0 +1,191 @@
+/**
+ * @file search_context.hpp
+ * @author osamy
+ * @brief per-query scratch state shared by the grid planners
+ */
+
+#ifndef SEARCH_CONTEXT_H_
+#define SEARCH_CONTEXT_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "indexed_heap.hpp"
+#include "search_stats.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief priority of a cell in the open list
+ */
+struct open_key_S
+{
+    /** \brief g-cost + heuristic cost */
+    double f;
+    /** \brief heuristic cost, used to break ties in favour of cells closer to the goal */
+    double h;
+
+    /**
+     * @brief overload < operator for comparison
+     * @param k - key to be compared
+     * @return whether this key has a higher priority than k
+     */
+    bool operator<(const open_key_S& k) const {
+        return f < k.f || (f == k.f && h < k.h);
+    }
+};
+
+/**
+ * @brief rounds an f-cost to a fixed number of fractional bits
+ * @param f - g-cost + heuristic cost
+ * @return rounded f-cost
+ * @details g-costs summed from diagonal moves and closed-form heuristics differ
+ * in the last bits for cells on equally good paths. without rounding those
+ * cells do not tie and the tie-break on h, which keeps the search on a single
+ * path, stops working. path costs are of the form a + b * sqrt(2) with
+ * integer a, b, and two different such costs are more than 2^-20 apart as long
+ * as a and b stay below ~10^5.
+ */
+inline double roundKey(const double f)
+{
+    return std::ldexp(std::nearbyint(std::ldexp(f, 20)), -20);
+}
+
+/**
+ * @brief holds the state a planner needs while answering a single query,
+ * kept apart from the (immutable) map so that the map never has to be copied.
+ * @details cells are addressed by their linear index in the map. the g-cost
+ * and parent of a cell are held in dense arrays, and every cell is tagged with
+ * the generation of the query that last wrote it. starting a new query only
+ * bumps the generation, so entries of previous queries become stale without
+ * touching them, and the cost of a query scales with the cells it visits
+ * rather than with the map size.
+ * the open list is part of the context as well; it holds every cell at most
+ * once and is emptied, not reallocated, between queries.
+ * the parent is stored in 32 bits, which limits maps to 2^32 cells.
+ */
+class SearchContext_C
+{
+public:
+    /**
+     * @brief prepares the context for a new query
+     * @param numCells - number of cells of the map to be searched
+     * @return void
+     * @details grows the buffers if needed, otherwise only the generation is
+     * bumped. the stamps are cleared once every 2^32 queries on wrap-around.
+     * the statistics of the previous query are cleared as well.
+     */
+    void reset(const int64_t numCells)
+    {
+        stats_ = SearchStats_S();
+        if (static_cast<int64_t>(seen_.size()) < numCells)
+        {
+            seen_.resize(numCells, 0);
+            closed_.resize(numCells, 0);
+            g_.resize(numCells);
+            parent_.resize(numCells);
+        }
+        open_.resize(numCells);
+        open_.clear();
+        if (0 == ++generation_)
+        {
+            std::fill(seen_.begin(), seen_.end(), 0);
+            std::fill(closed_.begin(), closed_.end(), 0);
+            generation_ = 1;
+        }
+    }
+
+    /**
+     * @brief checks whether a cell was reached during the current query
+     * @param idx - linear index of the cell
+     * @return bool whether the cell has a valid g-cost and parent
+     */
+    bool isSeen(const int64_t idx) const { return seen_[idx] == generation_; }
+
+    /**
+     * @brief g-cost of a cell in the current query
+     * @param idx - linear index of the cell
+     * @return best known cost from the start, infinity if not reached yet
+     */
+    double cost(const int64_t idx) const
+    {
+        return isSeen(idx) ? g_[idx] : std::numeric_limits<double>::infinity();
+    }
+
+    /**
+     * @brief parent of a cell in the current query
+     * @param idx - linear index of the cell
+     * @return linear index of the parent, only valid if isSeen(idx)
+     */
+    int64_t parent(const int64_t idx) const { return parent_[idx]; }
+
+    /**
+     * @brief records the g-cost and parent of a cell for the current query
+     * @param idx - linear index of the cell
+     * @param g - cost from the start
+     * @param parent - linear index of the parent
+     * @return void
+     */
+    void setCost(const int64_t idx, const double g, const int64_t parent)
+    {
+        seen_[idx] = generation_;
+        g_[idx] = g;
+        parent_[idx] = static_cast<uint32_t>(parent);
+    }
+
+    /**
+     * @brief checks whether a cell was expanded during the current query
+     * @param idx - linear index of the cell
+     * @return bool whether the cell is closed
+     */
+    bool isClosed(const int64_t idx) const { return closed_[idx] == generation_; }
+
+    /**
+     * @brief marks a cell as expanded during the current query
+     * @param idx - linear index of the cell
+     * @return void
+     */
+    void setClosed(const int64_t idx) { closed_[idx] = generation_; }
+
+    /**
+     * @brief open list of the current query
+     * @return reference to the open list
+     */
+    IndexedHeap_C<open_key_S>& open() { return open_; }
+
+    /**
+     * @brief statistics of the current query
+     * @return reference to the statistics, only written to with ENABLE_PLANNER_STATS
+     */
+    SearchStats_S& stats() { return stats_; }
+
+    /**
+     * @brief statistics of the current query
+     * @return const reference to the statistics
+     */
+    const SearchStats_S& stats() const { return stats_; }
+
+private:
+    /** \brief generation of the current query, 0 is never a valid generation */
+    uint32_t generation_ = 0;
+    /** \brief generation in which each cell's g-cost/parent were last written */
+    std::vector<uint32_t> seen_;
+    /** \brief generation in which each cell was last expanded */
+    std::vector<uint32_t> closed_;
+    /** \brief g-cost of each cell */
+    std::vector<double> g_;
+    /** \brief parent of each cell */
+    std::vector<uint32_t> parent_;
+    /** \brief open list, keyed by cell index */
+    IndexedHeap_C<open_key_S> open_;
+    /** \brief statistics of the current query */
+    SearchStats_S stats_;
+};
+
+} // namespace planning
+
+#endif /* SEARCH_CONTEXT_H_ */
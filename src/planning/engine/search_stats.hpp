@@ -0,0 +1,103 @@
+/**
+ * @file search_stats.hpp
+ * @author osamy
+ * @brief per-query search statistics of the grid planners
+ */
+
+#ifndef SEARCH_STATS_H_
+#define SEARCH_STATS_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+
+namespace planning
+{
+
+/**
+ * @brief counters and timings of a single query
+ * @details only filled in when built with ENABLE_PLANNER_STATS (cmake option
+ * PLANNER_STATS), otherwise the recording macros below expand to nothing and
+ * every field stays 0. the structure itself always exists so that code reading
+ * it builds either way.
+ * the timers nest: the heuristic is evaluated while generating neighbours, so
+ * heuristicNs is part of neighbourNs, and all of them are part of wallNs.
+ * timing single heuristic evaluations costs far more than the evaluations
+ * themselves, compare wall times with the option off.
+ */
+struct SearchStats_S
+{
+    /** \brief whether the planners were built to record statistics */
+#ifdef ENABLE_PLANNER_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif /* ENABLE_PLANNER_STATS */
+
+    /** \brief nodes taken off the open list and expanded */
+    uint64_t expanded = 0;
+    /** \brief pushes onto the open list, including duplicate pushes */
+    uint64_t pushed = 0;
+    /** \brief pushes of a node that was already in the open list, i.e. key updates */
+    uint64_t duplicatePushes = 0;
+    /** \brief largest number of nodes in the open list at once */
+    uint64_t maxOpenSize = 0;
+    /** \brief time spent evaluating the heuristic, in nanoseconds */
+    uint64_t heuristicNs = 0;
+    /** \brief time spent generating and relaxing neighbours, in nanoseconds */
+    uint64_t neighbourNs = 0;
+    /** \brief time spent building the returned path, in nanoseconds */
+    uint64_t reconstructionNs = 0;
+    /** \brief time spent in the whole query, in nanoseconds */
+    uint64_t wallNs = 0;
+};
+
+/**
+ * @brief adds the time from its construction to its destruction to a counter
+ */
+class StatsTimer_C
+{
+public:
+    /**
+     * @brief constructor, starts the timer
+     * @param ns - counter the elapsed nanoseconds are added to
+     */
+    explicit StatsTimer_C(uint64_t& ns) : ns_(ns), t0_(std::chrono::steady_clock::now()) {}
+
+    /**
+     * @brief destructor, stops the timer
+     */
+    ~StatsTimer_C()
+    {
+        ns_ += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0_).count());
+    }
+
+    StatsTimer_C(const StatsTimer_C&) = delete;
+    StatsTimer_C& operator=(const StatsTimer_C&) = delete;
+
+private:
+    uint64_t& ns_;
+    std::chrono::steady_clock::time_point t0_;
+};
+
+} // namespace planning
+
+#define PLANNER_STATS_CONCAT_(a, b) a##b
+#define PLANNER_STATS_CONCAT(a, b) PLANNER_STATS_CONCAT_(a, b)
+
+#ifdef ENABLE_PLANNER_STATS
+/** @brief adds v to a counter of a SearchStats_S */
+#define PLANNER_STATS_ADD(stats, field, v) ((stats).field += static_cast<uint64_t>(v))
+/** @brief raises a counter of a SearchStats_S to v if it is lower */
+#define PLANNER_STATS_MAX(stats, field, v) ((stats).field = std::max<uint64_t>((stats).field, (v)))
+/** @brief times the rest of the enclosing scope into a field of a SearchStats_S */
+#define PLANNER_STATS_TIMER(stats, field) \
+    planning::StatsTimer_C PLANNER_STATS_CONCAT(statsTimer_, __LINE__)((stats).field)
+#else
+#define PLANNER_STATS_ADD(stats, field, v) ((void)0)
+#define PLANNER_STATS_MAX(stats, field, v) ((void)0)
+#define PLANNER_STATS_TIMER(stats, field) ((void)0)
+#endif /* ENABLE_PLANNER_STATS */
+
+#endif /* SEARCH_STATS_H_ */
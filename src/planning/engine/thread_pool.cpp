@@ -0,0 +1,81 @@
+/**
+ * @file thread_pool.cpp
+ * @author osamy
+ * @brief contains the thread pool class implementation
+ */
+
+#include "thread_pool.hpp"
+
+planning::ThreadPool_C::ThreadPool_C(const size_t numThreads)
+{
+    for (size_t w = 1; w < numThreads; w++)
+    {
+        workers_.emplace_back(&ThreadPool_C::workerLoop, this, w);
+    }
+}
+
+planning::ThreadPool_C::~ThreadPool_C()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (auto& t : workers_)
+    {
+        t.join();
+    }
+}
+
+void planning::ThreadPool_C::parallelFor(const size_t count, const std::function<void(size_t, size_t)>& fn)
+{
+    std::lock_guard<std::mutex> jobLock(jobMutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = &fn;
+        count_ = count;
+        next_ = 0;
+        busy_ = workers_.size();
+        jobId_++;
+    }
+    start_.notify_all();
+
+    runIterations(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return 0 == busy_; });
+    fn_ = nullptr;
+}
+
+void planning::ThreadPool_C::workerLoop(const size_t worker)
+{
+    uint64_t seenJob = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [this, seenJob] { return stop_ || jobId_ != seenJob; });
+            if (stop_)
+            {
+                return;
+            }
+            seenJob = jobId_;
+        }
+
+        runIterations(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_--;
+        }
+        done_.notify_one();
+    }
+}
+
+void planning::ThreadPool_C::runIterations(const size_t worker)
+{
+    for (size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1))
+    {
+        (*fn_)(i, worker);
+    }
+}
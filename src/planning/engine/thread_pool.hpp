@@ -0,0 +1,101 @@
+/**
+ * @file thread_pool.hpp
+ * @author osamy
+ * @brief fixed size pool of worker threads
+ */
+
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace planning
+{
+
+/**
+ * @brief pool of worker threads that are created once and reused for every job
+ * @details a job is a loop over [0, count), the iterations are handed out to
+ * the workers one at a time, so uneven iterations still balance. the calling
+ * thread takes part as worker 0. jobs from different threads are serialised.
+ */
+class ThreadPool_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param numThreads - number of workers including the calling thread, at least 1
+     */
+    explicit ThreadPool_C(const size_t numThreads);
+
+    /**
+     * @brief destructor, stops and joins the workers
+     */
+    ~ThreadPool_C();
+
+    ThreadPool_C(const ThreadPool_C&) = delete;
+    ThreadPool_C& operator=(const ThreadPool_C&) = delete;
+
+    /**
+     * @brief number of workers
+     * @return number of workers including the calling thread
+     */
+    size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * @brief runs fn(i, worker) for every i in [0, count) and waits for all of them
+     * @param count - number of iterations
+     * @param fn - iteration body, worker is in [0, size()) and identifies the
+     * thread running the iteration, e.g. to pick per-thread scratch buffers
+     * @return void
+     */
+    void parallelFor(const size_t count, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    /** \brief worker threads, the calling thread is worker 0 and not in here */
+    std::vector<std::thread> workers_;
+    /** \brief serialises jobs */
+    std::mutex jobMutex_;
+    /** \brief protects the job state below */
+    std::mutex mutex_;
+    /** \brief wakes the workers when a job starts or the pool stops */
+    std::condition_variable start_;
+    /** \brief wakes the caller when the workers are done */
+    std::condition_variable done_;
+    /** \brief body of the current job */
+    const std::function<void(size_t, size_t)>* fn_ = nullptr;
+    /** \brief number of iterations of the current job */
+    size_t count_ = 0;
+    /** \brief next iteration to be handed out */
+    std::atomic<size_t> next_{0};
+    /** \brief incremented for every job, workers wait for it to change */
+    uint64_t jobId_ = 0;
+    /** \brief number of workers still running the current job */
+    size_t busy_ = 0;
+    /** \brief set when the pool is destroyed */
+    bool stop_ = false;
+
+    /**
+     * @brief loop of a worker thread
+     * @param worker - worker index
+     * @return void
+     */
+    void workerLoop(const size_t worker);
+
+    /**
+     * @brief runs iterations of the current job until none are left
+     * @param worker - worker index
+     * @return void
+     */
+    void runIterations(const size_t worker);
+};
+
+} // namespace planning
+
+#endif /* THREAD_POOL_H_ */
@@ -0,0 +1,239 @@
+/**
+ * @file arastar.cpp
+ * @author osamy
+ * @brief contains the ARA* class implementation
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "arastar.hpp"
+
+template <typename Motion_T, typename Heuristic_T>
+bool planning::BasicARAStar_C<Motion_T, Heuristic_T>::planInto(const Node_C& start, const Node_C& goal,
+                                                               std::vector<Node_C>& path)
+{
+    const deadline_T now = std::chrono::steady_clock::now();
+    /* an unlimited budget must not overflow the time point */
+    const auto timeBudget = std::min<std::chrono::nanoseconds>(timeBudget_, deadline_T::max() - now);
+    return planUntil(start, goal, now + timeBudget, maxExpansions_, path);
+}
+
+template <typename Motion_T, typename Heuristic_T>
+bool planning::BasicARAStar_C<Motion_T, Heuristic_T>::planUntil(const Node_C& start, const Node_C& goal,
+                                                                const deadline_T deadline,
+                                                                const uint64_t maxExpansions,
+                                                                std::vector<Node_C>& path)
+{
+    const bool found = search(start, goal, deadline, maxExpansions, path);
+#ifdef ENABLE_PLANNER_STATS
+    stats_ = ctx_.stats();
+#endif /* ENABLE_PLANNER_STATS */
+    return found;
+}
+
+template <typename Motion_T, typename Heuristic_T>
+bool planning::BasicARAStar_C<Motion_T, Heuristic_T>::search(const Node_C& start, const Node_C& goal,
+                                                             const deadline_T deadline, const uint64_t maxExpansions,
+                                                             std::vector<Node_C>& path)
+{
+    const uint8_t* const cells = padded_.data();
+    const int64_t stride = padded_.cols();
+    ctx_.reset(padded_.numCells());
+    path.clear();
+    bound_ = std::numeric_limits<double>::infinity();
+    numSearches_ = 0;
+    PLANNER_STATS_TIMER(ctx_.stats(), wallNs);
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+
+    IndexedHeap_C<open_key_S>& oList = ctx_.open();
+    const int64_t goalX = goal.x_ + 1;
+    const int64_t goalY = goal.y_ + 1;
+    const auto heuristic = [goalX, goalY, stride, this](const int64_t idx) {
+        PLANNER_STATS_TIMER(ctx_.stats(), heuristicNs);
+        return Heuristic_T()(idx / stride - goalX, idx % stride - goalY);
+    };
+    double weight = initialWeight_;
+    const auto key = [&heuristic, &weight, this](const int64_t idx) {
+        const double h = heuristic(idx);
+        return open_key_S{roundKey(ctx_.cost(idx) + weight * h), h};
+    };
+
+    const int64_t startIdx = padded_.index(start.x_ + 1, start.y_ + 1);
+    const int64_t goalIdx = padded_.index(goalX, goalY);
+    incons_.clear();
+    newSearch();
+    ctx_.setCost(startIdx, 0, startIdx);
+    oList.push(startIdx, key(startIdx));
+    PLANNER_STATS_ADD(ctx_.stats(), pushed, 1);
+    PLANNER_STATS_MAX(ctx_.stats(), maxOpenSize, 1);
+
+    uint64_t expanded = 0;
+    /* the clock costs about as much as an expansion, it is read every 64 of them */
+    const auto outOfBudget = [&expanded, maxExpansions, deadline]() {
+        return expanded >= maxExpansions
+            || (0 == (expanded & 63) && std::chrono::steady_clock::now() >= deadline);
+    };
+
+    while (true)
+    {
+        /* the search is done once no open cell can lead to a cheaper goal, the
+         * key of the goal being its g-cost */
+        while (!oList.empty() && roundKey(ctx_.cost(goalIdx)) > oList.topKey().f)
+        {
+            if (outOfBudget())
+            {
+                return numSearches_ > 0;
+            }
+            const int64_t curIdx = oList.top();
+            oList.pop();
+            closed_[curIdx] = search_;
+            expanded++;
+            PLANNER_STATS_ADD(ctx_.stats(), expanded, 1);
+            const double g = ctx_.cost(curIdx);
+
+            PLANNER_STATS_TIMER(ctx_.stats(), neighbourNs);
+#pragma GCC unroll 8
+            for (int m = 0; m < Motion_T::connectivity; m++)
+            {
+                const int64_t nIdx = curIdx + offsets_[m];
+                if (!isTraversable(cells[nIdx]))
+                {
+                    continue;
+                }
+                if (0 != Motion_T::dx[m] && 0 != Motion_T::dy[m]
+                    && (!isTraversable(cells[curIdx + Motion_T::dx[m] * stride])
+                        || !isTraversable(cells[curIdx + Motion_T::dy[m]])))
+                {
+                    continue;
+                }
+                const double newG = g + Motion_T::length[m] * cellCost(cells[nIdx]);
+                if (!(newG < ctx_.cost(nIdx)))
+                {
+                    continue;
+                }
+                ctx_.setCost(nIdx, newG, curIdx);
+                if (closed_[nIdx] != search_)
+                {
+                    PLANNER_STATS_ADD(ctx_.stats(), duplicatePushes, oList.contains(nIdx));
+                    oList.push(nIdx, key(nIdx));
+                    PLANNER_STATS_ADD(ctx_.stats(), pushed, 1);
+                    PLANNER_STATS_MAX(ctx_.stats(), maxOpenSize, oList.size());
+                }
+                else if (inconsistent_[nIdx] != search_)
+                {
+                    /* expanded once per search only, it waits for the next one */
+                    inconsistent_[nIdx] = search_;
+                    incons_.push_back(nIdx);
+                }
+            }
+        }
+        if (std::isinf(ctx_.cost(goalIdx)))
+        {
+            return false;
+        }
+
+        numSearches_++;
+        double cost = 0;
+        {
+            PLANNER_STATS_TIMER(ctx_.stats(), reconstructionNs);
+            cost = convertParents2Path(startIdx, goalIdx, path);
+        }
+        /* every cheaper path goes through a cell left open or inconsistent,
+         * whose g + h is then a lower bound of the optimal cost */
+        double lowerBound = cost;
+        for (const int64_t idx : incons_)
+        {
+            lowerBound = std::min(lowerBound, ctx_.cost(idx) + heuristic(idx));
+        }
+        /* the keys hold h, the g-costs may have dropped since they were set */
+        oList.forEach([&](const int64_t idx, const open_key_S& k) {
+            lowerBound = std::min(lowerBound, ctx_.cost(idx) + k.h);
+        });
+        bound_ = std::min(weight, (cost <= lowerBound) ? 1.0 : cost / lowerBound);
+        if (bound_ <= 1)
+        {
+            bound_ = 1;
+            return true;
+        }
+
+        /* the path is already within bound_, no point searching with more weight */
+        weight = std::max(1.0, std::min(weight - weightStep_, bound_));
+        newSearch();
+        for (const int64_t idx : incons_)
+        {
+            oList.push(idx, open_key_S{});
+            PLANNER_STATS_ADD(ctx_.stats(), pushed, 1);
+        }
+        incons_.clear();
+        oList.rekey(key);
+        PLANNER_STATS_MAX(ctx_.stats(), maxOpenSize, oList.size());
+    }
+}
+
+template <typename Motion_T, typename Heuristic_T>
+void planning::BasicARAStar_C<Motion_T, Heuristic_T>::pad()
+{
+    padded_ = padGrid(*map_, 1, static_cast<uint8_t>(1));
+    for (int m = 0; m < Motion_T::connectivity; m++)
+    {
+        offsets_[m] = Motion_T::dx[m] * padded_.cols() + Motion_T::dy[m];
+    }
+    closed_.assign(static_cast<size_t>(padded_.numCells()), 0);
+    inconsistent_.assign(static_cast<size_t>(padded_.numCells()), 0);
+    /* grown here rather than by the first query, which would miss its deadline;
+     * a cell is in incons_ and on a path at most once, so neither grows later */
+    ctx_.reset(padded_.numCells());
+    incons_.reserve(static_cast<size_t>(padded_.numCells()));
+    cells_.reserve(static_cast<size_t>(padded_.numCells()));
+}
+
+template <typename Motion_T, typename Heuristic_T>
+void planning::BasicARAStar_C<Motion_T, Heuristic_T>::newSearch()
+{
+    if (0 == ++search_)
+    {
+        std::fill(closed_.begin(), closed_.end(), 0);
+        std::fill(inconsistent_.begin(), inconsistent_.end(), 0);
+        search_ = 1;
+    }
+}
+
+template <typename Motion_T, typename Heuristic_T>
+double planning::BasicARAStar_C<Motion_T, Heuristic_T>::convertParents2Path(const int64_t startIdx,
+                                                                            const int64_t goalIdx,
+                                                                            std::vector<Node_C>& path)
+{
+    const uint8_t* const cells = padded_.data();
+    const int64_t stride = padded_.cols();
+    /* id of a cell in the map from its index in padded_ */
+    const auto toId = [this, stride](const int64_t idx) { return (idx / stride - 1) * cols_ + idx % stride - 1; };
+    cells_.clear();
+    for (int64_t cur = goalIdx; cur != startIdx; cur = ctx_.parent(cur))
+    {
+        cells_.push_back(cur);
+    }
+    cells_.push_back(startIdx);
+
+    /* the path of a previous search is replaced, costs are summed from the start */
+    path.resize(cells_.size());
+    double cost = 0;
+    path.back() = Node_C(startIdx / stride - 1, startIdx % stride - 1, 0, 0, toId(startIdx), toId(startIdx));
+    for (size_t i = cells_.size() - 1; i-- > 0;)
+    {
+        const int64_t cur = cells_[i];
+        const int64_t move = cur - cells_[i + 1];
+        const auto m = std::find(offsets_.begin(), offsets_.end(), move) - offsets_.begin();
+        cost += Motion_T::length[m] * cellCost(cells[cur]);
+        path[i] = Node_C(cur / stride - 1, cur % stride - 1, cost, 0, toId(cur), toId(cells_[i + 1]));
+    }
+    return cost;
+}
+
+template class planning::BasicARAStar_C<planning::FourConnected_S, planning::Manhattan_S>;
+template class planning::BasicARAStar_C<planning::EightConnected_S, planning::Octile_S>;
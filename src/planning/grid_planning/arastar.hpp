@@ -0,0 +1,209 @@
+/**
+ * @file arastar.hpp
+ * @author osamy
+ * @brief anytime repairing A* (ARA*) planner class
+ */
+
+#ifndef ARASTAR_H_
+#define ARASTAR_H_
+
+#include <array>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "search_context.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the ARA* algorithm, anytime A* under a time or expansion budget
+ * @tparam Motion_T - motion model, e.g. FourConnected_S
+ * @tparam Heuristic_T - heuristic functor, consistent for Motion_T
+ */
+template <typename Motion_T, typename Heuristic_T>
+class BasicARAStar_C : public GPEngine_C
+{
+    static_assert(Motion_T::connectivity <= Heuristic_T::maxConnectivity,
+                  "heuristic is not admissible for the motion model");
+
+public:
+    /** \brief point in time a query must return by */
+    using deadline_T = std::chrono::steady_clock::time_point;
+
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @param initialWeight - heuristic weight of the first search, at least 1
+     * @param weightStep - decrease of the weight after every search, 0 to go
+     * straight to weight 1 after the first path
+     * @return none
+     */
+    explicit BasicARAStar_C(OccupancyGrid_C grid, const double initialWeight = 3.0, const double weightStep = 0.5)
+                : GPEngine_C(std::move(grid)) { pad(); setWeights(initialWeight, weightStep); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @param initialWeight - heuristic weight of the first search, at least 1
+     * @param weightStep - decrease of the weight after every search, 0 to go
+     * straight to weight 1 after the first path
+     * @return none
+     */
+    explicit BasicARAStar_C(std::shared_ptr<const OccupancyGrid_C> map, const double initialWeight = 3.0,
+                            const double weightStep = 0.5)
+                : GPEngine_C(std::move(map)) { pad(); setWeights(initialWeight, weightStep); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller,
+     * within the budget set by setBudget()
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if none was found
+     * @return bool whether a path was found
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief algorithm's implementation until a deadline
+     * @param start - start node
+     * @param goal - goal node
+     * @param deadline - time by which the query returns
+     * @param maxExpansions - largest number of cells expanded by the query
+     * @param path - receives the best path from goal to start, empty if none was found
+     * @return bool whether a path was found; false too if the budget ran out
+     * before the first search completed
+     * @details a first search inflates the heuristic by the initial weight,
+     * each later one lowers the weight and only expands again the cells whose
+     * cost dropped since they were expanded. every completed search replaces
+     * the path, one cut short by the budget is dropped. the clock is read every
+     * few expansions, so the query returns within a few microseconds after the
+     * deadline; with an expansion budget only, the path is always the same.
+     */
+    bool planUntil(const Node_C& start, const Node_C& goal, const deadline_T deadline, const uint64_t maxExpansions,
+                   std::vector<Node_C>& path);
+
+    /**
+     * @brief sets the budget of plan() and planInto()
+     * @param timeBudget - time a query may take, from its start
+     * @param maxExpansions - largest number of cells expanded by a query
+     * @return void
+     * @details unlimited by default, so queries search down to weight 1 and
+     * return an optimal path
+     */
+    void setBudget(const std::chrono::nanoseconds timeBudget,
+                   const uint64_t maxExpansions = std::numeric_limits<uint64_t>::max())
+    {
+        timeBudget_ = timeBudget;
+        maxExpansions_ = maxExpansions;
+    }
+
+    /**
+     * @brief sets the heuristic weights of the searches
+     * @param initialWeight - heuristic weight of the first search, at least 1
+     * @param weightStep - decrease of the weight after every search, 0 to go
+     * straight to weight 1 after the first path
+     * @return void
+     */
+    void setWeights(const double initialWeight, const double weightStep)
+    {
+        initialWeight_ = std::max(1.0, initialWeight);
+        weightStep_ = (weightStep > 0) ? weightStep : initialWeight_;
+    }
+
+    /**
+     * @brief suboptimality bound of the path of the last query
+     * @return the path costs at most this times the optimal cost, 1 if it is
+     * optimal, infinity if no path was found
+     * @details the path cost over the smallest g + h of the cells left to
+     * expand, capped by the weight of the last search
+     */
+    double getBound() const { return bound_; }
+
+    /**
+     * @brief number of searches the last query completed
+     * @return number of searches, each with a lower weight than the one before
+     */
+    uint32_t getNumSearches() const { return numSearches_; }
+
+private:
+    /** \brief g-costs, parents and open list of the current query */
+    SearchContext_C ctx_;
+    /** \brief the map with a border of obstacles around it */
+    OccupancyGrid_C padded_;
+    /** \brief index offset of the neighbour reached by each motion in padded_ */
+    std::array<int64_t, Motion_T::connectivity> offsets_{};
+    /** \brief heuristic weight of the first search */
+    double initialWeight_ = 3.0;
+    /** \brief decrease of the weight after every search */
+    double weightStep_ = 0.5;
+    /** \brief time a query of plan() may take */
+    std::chrono::nanoseconds timeBudget_ = std::chrono::nanoseconds::max();
+    /** \brief cells a query of plan() may expand */
+    uint64_t maxExpansions_ = std::numeric_limits<uint64_t>::max();
+    /** \brief search in which each cell was last expanded */
+    std::vector<uint32_t> closed_;
+    /** \brief search in which each cell was last added to incons_ */
+    std::vector<uint32_t> inconsistent_;
+    /** \brief number of the current search, over all queries; 0 is never a search */
+    uint32_t search_ = 0;
+    /** \brief cells whose cost dropped after they were expanded in the current search */
+    std::vector<int64_t> incons_;
+    /** \brief cells from the goal to the start of the last path */
+    std::vector<int64_t> cells_;
+    /** \brief suboptimality bound of the last path */
+    double bound_ = std::numeric_limits<double>::infinity();
+    /** \brief number of searches completed by the last query */
+    uint32_t numSearches_ = 0;
+
+    /**
+     * @brief builds padded_ and offsets_ from the map
+     * @return void
+     */
+    void pad();
+
+    /**
+     * @brief starts a new search, in which no cell is closed or inconsistent yet
+     * @return void
+     */
+    void newSearch();
+
+    /**
+     * @brief algorithm's implementation, see planUntil()
+     * @param start - start node
+     * @param goal - goal node
+     * @param deadline - time by which the query returns
+     * @param maxExpansions - largest number of cells expanded by the query
+     * @param path - receives the best path from goal to start
+     * @return bool whether a path was found
+     */
+    bool search(const Node_C& start, const Node_C& goal, const deadline_T deadline, const uint64_t maxExpansions,
+                std::vector<Node_C>& path);
+
+    /**
+     * @brief builds the path by following the parents from the goal to the start
+     * @param startIdx - index of the start cell in padded_
+     * @param goalIdx - index of the goal cell in padded_
+     * @param path - receives the path from goal to start, with the costs along it
+     * @return double cost of the path
+     * @details the g-costs of the cells may be lower than the cost along the
+     * path when their parents improved later, so the costs are summed again
+     */
+    double convertParents2Path(const int64_t startIdx, const int64_t goalIdx, std::vector<Node_C>& path);
+};
+
+/** \brief ARA* moving to the 4 edge neighbours, with the manhattan heuristic */
+using ARAStar_C = BasicARAStar_C<FourConnected_S, Manhattan_S>;
+/** \brief ARA* moving to the 8 edge and corner neighbours, with the octile heuristic */
+using ARAStar8_C = BasicARAStar_C<EightConnected_S, Octile_S>;
+
+extern template class BasicARAStar_C<FourConnected_S, Manhattan_S>;
+extern template class BasicARAStar_C<EightConnected_S, Octile_S>;
+
+} // namespace planning
+
+#endif /* ARASTAR_H_ */
@@ -5,8 +5,7 @@
  */
 
 #include <cmath>
-#include <queue>
-#include <unordered_set>
+#include <cstdlib>
 #include <vector>
 
 #ifdef STANDALONE_BUILD_ASTAR
@@ -15,86 +14,159 @@
 
 #include "astar.hpp"
 
-std::tuple<bool, std::vector<Node_C>> planning::AStar_C::plan(const Node_C& start,
-                                                              const Node_C& goal)
+template <typename Motion_T, typename Heuristic_T, typename Cell_T>
+bool planning::BasicAStar_C<Motion_T, Heuristic_T, Cell_T>::planInto(const Node_C& start, const Node_C& goal,
+                                                                     std::vector<Node_C>& path)
 {
-    grid_ = original_grid_;
-    std::priority_queue<Node_C, std::vector<Node_C>, compare_cost_S> oList;
-    std::unordered_set<Node_C, NodeIdHash_C, compare_coord_S> cList;
+    const bool found = planWithContext(start, goal, ctx_, path);
+#ifdef ENABLE_PLANNER_STATS
+    stats_ = ctx_.stats();
+#endif /* ENABLE_PLANNER_STATS */
+    return found;
+}
 
-    const std::vector<Node_C> perMotion = getPermissibleMotion();
+template <typename Motion_T, typename Heuristic_T, typename Cell_T>
+bool planning::BasicAStar_C<Motion_T, Heuristic_T, Cell_T>::planWithContext(const Node_C& start, const Node_C& goal,
+                                                                            SearchContext_C& ctx,
+                                                                            std::vector<Node_C>& path) const
+{
+    const Cell_T* const cells = padded_.data();
+    const int64_t stride = padded_.cols();
+    ctx.reset(padded_.numCells());
+    path.clear();
+    PLANNER_STATS_TIMER(ctx.stats(), wallNs);
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+
+    IndexedHeap_C<open_key_S>& oList = ctx.open();
+
+    /* coordinates below are coordinates in padded_, the border shifts start,
+     * goal and every cell alike, so differences are unchanged */
+    const int64_t goalX = goal.x_ + 1;
+    const int64_t goalY = goal.y_ + 1;
+    const Landmarks_C* const landmarks = landmarks_.get();
+    /* cells of the landmarks are cells of the map, without the border */
+    const int64_t goalCell = goal.x_ * cols_ + goal.y_;
+    const int64_t mapCols = cols_;
+    const auto heuristic = [goalX, goalY, stride, landmarks, goalCell, mapCols, &ctx](const int64_t idx) {
+        PLANNER_STATS_TIMER(ctx.stats(), heuristicNs);
+        const int64_t x = idx / stride;
+        const int64_t y = idx % stride;
+        const double h = Heuristic_T()(x - goalX, y - goalY);
+        if (nullptr == landmarks)
+        {
+            return h;
+        }
+        return std::max(h, landmarks->lowerBound((x - 1) * mapCols + y - 1, goalCell));
+    };
 
-    oList.push(start);
+    const int64_t startIdx = padded_.index(start.x_ + 1, start.y_ + 1);
+    const int64_t goalIdx = padded_.index(goalX, goalY);
+    const double startH = heuristic(startIdx);
+
+    ctx.setCost(startIdx, 0, startIdx);
+    oList.push(startIdx, {roundKey(startH), startH});
+    PLANNER_STATS_ADD(ctx.stats(), pushed, 1);
+    PLANNER_STATS_MAX(ctx.stats(), maxOpenSize, 1);
 
     while (!oList.empty())
     {
-        Node_C cur = oList.top();
+        const int64_t curIdx = oList.top();
         oList.pop();
+        ctx.setClosed(curIdx);
+        PLANNER_STATS_ADD(ctx.stats(), expanded, 1);
 
-        cur.id_ = cur.x_ * n_ + cur.y_;
-
-        if (compareCoordinates(cur, goal))
+        if (curIdx == goalIdx)
         {
-            cList.insert(cur);
-            grid_[cur.x_][cur.y_] = 2;
-            return {true, convertClosedList2Path(cList, start, goal)};
+            PLANNER_STATS_TIMER(ctx.stats(), reconstructionNs);
+            convertParents2Path(ctx, startIdx, goalIdx, path);
+            return true;
         }
 
-        grid_[cur.x_][cur.y_] = 2;
+        const double g = ctx.cost(curIdx);
 
-        for (const auto& pm : perMotion)
+        PLANNER_STATS_TIMER(ctx.stats(), neighbourNs);
+#pragma GCC unroll 8
+        for (int m = 0; m < Motion_T::connectivity; m++)
         {
-            Node_C newPoint = cur + pm;
-            newPoint.id_ = n_ * newPoint.x_ + newPoint.y_;
-            newPoint.pId_ = cur.id_;
-            newPoint.hCost_ = fabs(newPoint.x_ - goal.x_) + fabs(newPoint.y_ - goal.y_);
-
-            if (compareCoordinates(newPoint, goal))
+            /* the border is made of obstacles, so no neighbour is ever outside padded_ */
+            const int64_t nIdx = curIdx + offsets_[m];
+            if (!isTraversable(cells[nIdx]) || ctx.isClosed(nIdx))
             {
-                oList.push(newPoint);
-                break;
+                continue;
             }
-            if (checkOutsideBoundary(newPoint, n_))
+            /* no corner cutting, both cells beside a diagonal move must be enterable */
+            if (0 != Motion_T::dx[m] && 0 != Motion_T::dy[m]
+                && (!isTraversable(cells[curIdx + Motion_T::dx[m] * stride])
+                    || !isTraversable(cells[curIdx + Motion_T::dy[m]])))
             {
                 continue;
             }
-            if (0 != grid_[newPoint.x_][newPoint.y_])
+            /* relax against the best known g, the heap holds each cell once
+             * and push() lowers the key of a cell that is already open */
+            const double newG = g + Motion_T::length[m] * cellCost(cells[nIdx]);
+            if (newG < ctx.cost(nIdx))
             {
-                continue;
+                const double h = heuristic(nIdx);
+                ctx.setCost(nIdx, newG, curIdx);
+                PLANNER_STATS_ADD(ctx.stats(), duplicatePushes, oList.contains(nIdx));
+                oList.push(nIdx, {roundKey(newG + h), h});
+                PLANNER_STATS_ADD(ctx.stats(), pushed, 1);
+                PLANNER_STATS_MAX(ctx.stats(), maxOpenSize, oList.size());
             }
-            oList.push(newPoint);
         }
-        cList.insert(cur);
     }
-    return {false, {}};
+    return false;
 }
 
-std::vector<Node_C> planning::AStar_C::convertClosedList2Path(
-                                        std::unordered_set<Node_C, NodeIdHash_C, compare_coord_S>& cList,
-                                        const Node_C& start, const Node_C& goal)
+template <typename Motion_T, typename Heuristic_T, typename Cell_T>
+bool planning::BasicAStar_C<Motion_T, Heuristic_T, Cell_T>::setLandmarks(std::shared_ptr<const Landmarks_C> landmarks)
 {
-    auto cur = *cList.find(goal);
-    std::vector<Node_C> path;
+    if (landmarks && (FourConnected_S::connectivity != Motion_T::connectivity || !landmarks->matches(*map_)))
+    {
+        landmarks_.reset();
+        return false;
+    }
+    landmarks_ = std::move(landmarks);
+    return true;
+}
 
-    while (!compareCoordinates(cur, start))
+template <typename Motion_T, typename Heuristic_T, typename Cell_T>
+void planning::BasicAStar_C<Motion_T, Heuristic_T, Cell_T>::pad()
+{
+    padded_ = padGrid(*map_, 1, static_cast<Cell_T>(1));
+    for (int m = 0; m < Motion_T::connectivity; m++)
     {
-        path.push_back(cur);
+        offsets_[m] = Motion_T::dx[m] * padded_.cols() + Motion_T::dy[m];
+    }
+}
 
-        if (const auto it = cList.find(Node_C(cur.pId_ / n_, cur.pId_ % n_, 0, 0, cur.pId_));
-            it != cList.end())
-        {
-            cur = *it;
-        }
-        else
-        {
-            std::cout << "Error in calculating path\n";
-            return {};
-        }
+template <typename Motion_T, typename Heuristic_T, typename Cell_T>
+void planning::BasicAStar_C<Motion_T, Heuristic_T, Cell_T>::convertParents2Path(const SearchContext_C& ctx,
+                                                                                const int64_t startIdx,
+                                                                                const int64_t goalIdx,
+                                                                                std::vector<Node_C>& path) const
+{
+    const int64_t stride = padded_.cols();
+    /* id of a cell in the map from its index in padded_ */
+    const auto toId = [this, stride](const int64_t idx) { return (idx / stride - 1) * cols_ + idx % stride - 1; };
+    int64_t cur = goalIdx;
+
+    while (cur != startIdx)
+    {
+        const int64_t pIdx = ctx.parent(cur);
+        path.emplace_back(cur / stride - 1, cur % stride - 1, ctx.cost(cur), 0, toId(cur), toId(pIdx));
+        cur = pIdx;
     }
-    path.push_back(start);
-    return path;
+    path.emplace_back(startIdx / stride - 1, startIdx % stride - 1, 0, 0, toId(startIdx), toId(startIdx));
 }
 
+template class planning::BasicAStar_C<planning::FourConnected_S, planning::Manhattan_S>;
+template class planning::BasicAStar_C<planning::EightConnected_S, planning::Octile_S>;
+template class planning::BasicAStar_C<planning::FourConnected_S, planning::Zero_S>;
+
 #ifdef STANDALONE_BUILD_ASTAR
 /**
  * @brief script main function. generates start and end nodes as well as grid,
@@ -104,12 +176,12 @@ std::vector<Node_C> planning::AStar_C::convertClosedList2Path(
 int main()
 {
     constexpr int n = 11;
-    std::vector<std::vector<int64_t>> grid(n, std::vector<int64_t>(n, 0));
+    OccupancyGrid_C grid(n, n, 0);
 
-    makeGrid(grid);
+    constexpr uint32_t seed = 42;
+    makeGrid(grid, seed, 2.0 / static_cast<double>(n + 1));
 
-    std::random_device rd;
-    std::mt19937 eng(rd());
+    std::mt19937 eng(seed);
     std::uniform_int_distribution<int64_t> distr(0, n - 1);
 
     Node_C start(distr(eng), distr(eng), 0, 0, 0, 0);
@@ -120,8 +192,8 @@ int main()
     goal.id_ = goal.x_ * n + goal.y_;
     start.hCost_ = abs(start.x_ - goal.x_) + abs(start.y_ - goal.y_);
 
-    grid[start.x_][start.y_] = 0;
-    grid[goal.x_][goal.y_] = 0;
+    grid(start.x_, start.y_) = 0;
+    grid(goal.x_, goal.y_) = 0;
 
     start.printStatus();
     goal.printStatus();
@@ -7,9 +7,13 @@
 #ifndef ASTAR_H_
 #define ASTAR_H_
 
+#include <array>
 #include <queue>
 
 #include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "landmarks.hpp"
+#include "search_context.hpp"
 #include "utils.hpp"
 
 namespace planning
@@ -17,33 +21,112 @@ namespace planning
 
 /**
  * @brief class for using A* algorithm
+ * @tparam Motion_T - motion model, e.g. FourConnected_S
+ * @tparam Heuristic_T - heuristic functor, admissible for Motion_T
+ * @tparam Cell_T - cell type of the padded copy, must hold every cell value
  */
-class AStar_C : public GPEngine_C
+template <typename Motion_T, typename Heuristic_T, typename Cell_T = uint8_t>
+class BasicAStar_C : public GPEngine_C
 {
+    static_assert(Motion_T::connectivity <= Heuristic_T::maxConnectivity,
+                  "heuristic is not admissible for the motion model");
+
 public:
     /**
      * @brief constructor
      * @param grid - grid map for the planning task
      * @return none
      */
-    explicit AStar_C(std::vector<std::vector<int64_t>> grid)
-                : GPEngine_C(std::move(grid)) {}
+    explicit BasicAStar_C(OccupancyGrid_C grid)
+                : GPEngine_C(std::move(grid)) { pad(); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @return none
+     */
+    explicit BasicAStar_C(std::shared_ptr<const OccupancyGrid_C> map)
+                : GPEngine_C(std::move(map)) { pad(); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details allocation-free once the search context and the path have
+     * grown to the largest query so far
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief adds the landmark lower bound to the heuristic
+     * @param landmarks - landmarks of the planner's map, null to plan without them
+     * @return bool whether the landmarks are used; they are not if they were
+     * computed on another map, or for a motion model other than 4-connected,
+     * whose costs they could overestimate
+     * @details the heuristic becomes the larger of Heuristic_T and the
+     * landmark bound, which is consistent as both are. the landmarks are
+     * shared, read-only, by every query, batched ones included.
+     */
+    bool setLandmarks(std::shared_ptr<const Landmarks_C> landmarks);
+
+protected:
+    /**
+     * @brief A* can answer queries concurrently, each with its own context
+     * @return true
+     */
+    bool supportsConcurrentQueries() const override { return true; }
 
     /**
-     * @brief algorithm's implementation
+     * @brief algorithm's implementation on an explicit search context
      * @param start - start node
      * @param goal - goal node
-     * @return typle contains a bool to whether there was a path,
-     * with the respective path.
+     * @param ctx - search context holding all per-query state
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
      */
-    std::tuple<bool, std::vector<Node_C>> plan(const Node_C& start,
-                                               const Node_C& goal) override;
+    bool planWithContext(const Node_C& start, const Node_C& goal, SearchContext_C& ctx,
+                         std::vector<Node_C>& path) const override;
 
 private:
-    std::vector<Node_C> convertClosedList2Path(std::unordered_set<Node_C, NodeIdHash_C, compare_coord_S>& cList,
-                                               const Node_C& start, const Node_C& goal);
+    /** \brief per-query g-cost/parent/closed state and open list, reused between calls to plan() */
+    SearchContext_C ctx_;
+    /** \brief the map with a border of obstacles around it */
+    Grid_C<Cell_T> padded_;
+    /** \brief index offset of the neighbour reached by each motion in padded_ */
+    std::array<int64_t, Motion_T::connectivity> offsets_{};
+    /** \brief landmarks of the map, null if the heuristic is Heuristic_T alone */
+    std::shared_ptr<const Landmarks_C> landmarks_;
+
+    /**
+     * @brief builds padded_ and offsets_ from the map
+     * @return void
+     */
+    void pad();
+
+    /**
+     * @brief builds the path by following the parents from the goal to the start
+     * @param ctx - search context of the query
+     * @param startIdx - index of the start cell in padded_
+     * @param goalIdx - index of the goal cell in padded_
+     * @param path - receives the path from goal to start
+     * @return void
+     */
+    void convertParents2Path(const SearchContext_C& ctx, const int64_t startIdx,
+                             const int64_t goalIdx, std::vector<Node_C>& path) const;
 };
 
+/** \brief A* moving to the 4 edge neighbours, with the manhattan heuristic */
+using AStar_C = BasicAStar_C<FourConnected_S, Manhattan_S>;
+/** \brief A* moving to the 8 edge and corner neighbours, with the octile heuristic */
+using AStar8_C = BasicAStar_C<EightConnected_S, Octile_S>;
+/** \brief Dijkstra's algorithm moving to the 4 edge neighbours */
+using Dijkstra_C = BasicAStar_C<FourConnected_S, Zero_S>;
+
+extern template class BasicAStar_C<FourConnected_S, Manhattan_S>;
+extern template class BasicAStar_C<EightConnected_S, Octile_S>;
+extern template class BasicAStar_C<FourConnected_S, Zero_S>;
 
 } // namespace planning
 
@@ -0,0 +1,202 @@
+/**
+ * @file biastar.cpp
+ * @author osamy
+ * @brief contains the bidirectional A* class implementation
+ */
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "biastar.hpp"
+
+template <typename Motion_T, typename Heuristic_T>
+bool planning::BasicBiAStar_C<Motion_T, Heuristic_T>::planInto(const Node_C& start, const Node_C& goal,
+                                                               std::vector<Node_C>& path)
+{
+    const bool found = search(start, goal, path);
+#ifdef ENABLE_PLANNER_STATS
+    stats_ = fwd_.stats();
+#endif /* ENABLE_PLANNER_STATS */
+    return found;
+}
+
+template <typename Motion_T, typename Heuristic_T>
+bool planning::BasicBiAStar_C<Motion_T, Heuristic_T>::search(const Node_C& start, const Node_C& goal,
+                                                             std::vector<Node_C>& path)
+{
+    const uint8_t* const cells = padded_.data();
+    const int64_t stride = padded_.cols();
+    fwd_.reset(padded_.numCells());
+    bwd_.reset(padded_.numCells());
+    path.clear();
+    /* both searches record into the statistics of the forward context */
+    SearchStats_S& stats = fwd_.stats();
+    PLANNER_STATS_TIMER(stats, wallNs);
+
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+    const int64_t startIdx = padded_.index(start.x_ + 1, start.y_ + 1);
+    const int64_t goalIdx = padded_.index(goal.x_ + 1, goal.y_ + 1);
+    if (!isTraversable(cells[goalIdx]))
+    {
+        return false;
+    }
+    if (startIdx == goalIdx)
+    {
+        convertParents2Path(startIdx, startIdx, goalIdx, 0, path);
+        return true;
+    }
+
+    /* heuristic distances to the goal and to the start */
+    const auto hGoal = [goalIdx, stride, &stats](const int64_t idx) {
+        PLANNER_STATS_TIMER(stats, heuristicNs);
+        return Heuristic_T()(idx / stride - goalIdx / stride, idx % stride - goalIdx % stride);
+    };
+    const auto hStart = [startIdx, stride, &stats](const int64_t idx) {
+        PLANNER_STATS_TIMER(stats, heuristicNs);
+        return Heuristic_T()(idx / stride - startIdx / stride, idx % stride - startIdx % stride);
+    };
+
+    IndexedHeap_C<open_key_S>& fList = fwd_.open();
+    IndexedHeap_C<open_key_S>& bList = bwd_.open();
+    fwd_.setCost(startIdx, 0, startIdx);
+    fList.push(startIdx, {roundKey(hGoal(startIdx)), hGoal(startIdx)});
+    bwd_.setCost(goalIdx, 0, goalIdx);
+    bList.push(goalIdx, {roundKey(hStart(goalIdx)), hStart(goalIdx)});
+    PLANNER_STATS_ADD(stats, pushed, 2);
+    PLANNER_STATS_MAX(stats, maxOpenSize, 2);
+
+    /* cost of the best path found so far and the cell it goes through */
+    double best = std::numeric_limits<double>::infinity();
+    int64_t meetIdx = -1;
+
+    /* the keys are rounded (see roundKey), compare them to the rounded cost */
+    const auto done = [&fList, &bList, &best]() {
+        const double bound = roundKey(best);
+        if (fList.topKey().f >= bound || bList.topKey().f >= bound)
+        {
+            return true;
+        }
+        return std::is_same<Heuristic_T, Zero_S>::value && fList.topKey().f + bList.topKey().f >= bound;
+    };
+
+    while (!fList.empty() && !bList.empty() && !done())
+    {
+        const bool forward = fList.size() <= bList.size();
+        SearchContext_C& ctx = forward ? fwd_ : bwd_;
+        const SearchContext_C& other = forward ? bwd_ : fwd_;
+        IndexedHeap_C<open_key_S>& oList = ctx.open();
+
+        const int64_t curIdx = oList.top();
+        oList.pop();
+        ctx.setClosed(curIdx);
+        if (other.isClosed(curIdx))
+        {
+            /* every path through the cell was found when the other side expanded it */
+            continue;
+        }
+        PLANNER_STATS_ADD(stats, expanded, 1);
+        const double g = ctx.cost(curIdx);
+        /* the backward search follows edges in reverse, into the current cell */
+        const double curCost = cellCost(cells[curIdx]);
+
+        PLANNER_STATS_TIMER(stats, neighbourNs);
+#pragma GCC unroll 8
+        for (int m = 0; m < Motion_T::connectivity; m++)
+        {
+            const int64_t nIdx = curIdx + offsets_[m];
+            /* the start may be left even if it is an obstacle, as in BasicAStar_C */
+            if ((!isTraversable(cells[nIdx]) && (forward || nIdx != startIdx)) || ctx.isClosed(nIdx))
+            {
+                continue;
+            }
+            /* no corner cutting, the cells beside a move are the same in both directions */
+            if (0 != Motion_T::dx[m] && 0 != Motion_T::dy[m]
+                && (!isTraversable(cells[curIdx + Motion_T::dx[m] * stride])
+                    || !isTraversable(cells[curIdx + Motion_T::dy[m]])))
+            {
+                continue;
+            }
+            const double newG = g + Motion_T::length[m] * (forward ? cellCost(cells[nIdx]) : curCost);
+            if (newG < ctx.cost(nIdx))
+            {
+                const double h = forward ? hGoal(nIdx) : hStart(nIdx);
+                ctx.setCost(nIdx, newG, curIdx);
+                PLANNER_STATS_ADD(stats, duplicatePushes, oList.contains(nIdx));
+                oList.push(nIdx, {roundKey(newG + h), h});
+                PLANNER_STATS_ADD(stats, pushed, 1);
+                PLANNER_STATS_MAX(stats, maxOpenSize, fList.size() + bList.size());
+
+                if (other.isSeen(nIdx) && newG + other.cost(nIdx) < best)
+                {
+                    best = newG + other.cost(nIdx);
+                    meetIdx = nIdx;
+                }
+            }
+        }
+    }
+
+    if (meetIdx < 0)
+    {
+        return false;
+    }
+    PLANNER_STATS_TIMER(stats, reconstructionNs);
+    convertParents2Path(meetIdx, startIdx, goalIdx, best, path);
+    return true;
+}
+
+template <typename Motion_T, typename Heuristic_T>
+void planning::BasicBiAStar_C<Motion_T, Heuristic_T>::pad()
+{
+    padded_ = padGrid(*map_, 1, static_cast<uint8_t>(1));
+    for (int m = 0; m < Motion_T::connectivity; m++)
+    {
+        offsets_[m] = Motion_T::dx[m] * padded_.cols() + Motion_T::dy[m];
+    }
+    /* a cell is on the path at most once, so queries never grow these */
+    fwd_.reset(padded_.numCells());
+    bwd_.reset(padded_.numCells());
+    toGoal_.reserve(static_cast<size_t>(padded_.numCells()));
+}
+
+template <typename Motion_T, typename Heuristic_T>
+void planning::BasicBiAStar_C<Motion_T, Heuristic_T>::convertParents2Path(const int64_t meetIdx,
+                                                                          const int64_t startIdx,
+                                                                          const int64_t goalIdx,
+                                                                          const double cost,
+                                                                          std::vector<Node_C>& path)
+{
+    const int64_t stride = padded_.cols();
+    /* id of a cell in the map from its index in padded_ */
+    const auto toId = [this, stride](const int64_t idx) { return (idx / stride - 1) * cols_ + idx % stride - 1; };
+
+    /* cells from the meeting cell to the goal, their parents in the backward
+     * search are one step closer to the goal */
+    toGoal_.assign(1, meetIdx);
+    while (toGoal_.back() != goalIdx)
+    {
+        toGoal_.push_back(bwd_.parent(toGoal_.back()));
+    }
+    for (size_t i = toGoal_.size() - 1; i > 0; i--)
+    {
+        const int64_t cur = toGoal_[i];
+        path.emplace_back(cur / stride - 1, cur % stride - 1, cost - bwd_.cost(cur), 0, toId(cur), toId(toGoal_[i - 1]));
+    }
+
+    int64_t cur = meetIdx;
+    while (cur != startIdx)
+    {
+        const int64_t pIdx = fwd_.parent(cur);
+        path.emplace_back(cur / stride - 1, cur % stride - 1, fwd_.cost(cur), 0, toId(cur), toId(pIdx));
+        cur = pIdx;
+    }
+    path.emplace_back(startIdx / stride - 1, startIdx % stride - 1, 0, 0, toId(startIdx), toId(startIdx));
+}
+
+template class planning::BasicBiAStar_C<planning::FourConnected_S, planning::Manhattan_S>;
+template class planning::BasicBiAStar_C<planning::EightConnected_S, planning::Octile_S>;
+template class planning::BasicBiAStar_C<planning::FourConnected_S, planning::Zero_S>;
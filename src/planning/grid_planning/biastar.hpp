@@ -0,0 +1,112 @@
+/**
+ * @file biastar.hpp
+ * @author osamy
+ * @brief bidirectional A* planner class
+ */
+
+#ifndef BIASTAR_H_
+#define BIASTAR_H_
+
+#include <array>
+
+#include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "search_context.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the bidirectional A* algorithm
+ * @tparam Motion_T - motion model, e.g. FourConnected_S
+ * @tparam Heuristic_T - heuristic functor, admissible for Motion_T
+ */
+template <typename Motion_T, typename Heuristic_T>
+class BasicBiAStar_C : public GPEngine_C
+{
+    static_assert(Motion_T::connectivity <= Heuristic_T::maxConnectivity,
+                  "heuristic is not admissible for the motion model");
+
+public:
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @return none
+     */
+    explicit BasicBiAStar_C(OccupancyGrid_C grid)
+                : GPEngine_C(std::move(grid)) { pad(); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @return none
+     */
+    explicit BasicBiAStar_C(std::shared_ptr<const OccupancyGrid_C> map)
+                : GPEngine_C(std::move(map)) { pad(); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details allocation-free once the search contexts and the path have
+     * grown to the largest query so far
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+private:
+    /** \brief state of the search from the start */
+    SearchContext_C fwd_;
+    /** \brief state of the search from the goal, costs are costs to the goal */
+    SearchContext_C bwd_;
+    /** \brief the map with a border of obstacles around it */
+    OccupancyGrid_C padded_;
+    /** \brief index offset of the neighbour reached by each motion in padded_ */
+    std::array<int64_t, Motion_T::connectivity> offsets_{};
+    /** \brief cells from the meeting cell to the goal, reused between queries */
+    std::vector<int64_t> toGoal_;
+
+    /**
+     * @brief runs both searches, see plan()
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     */
+    bool search(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path);
+
+    /**
+     * @brief builds padded_ and offsets_ from the map
+     * @return void
+     */
+    void pad();
+
+    /**
+     * @brief builds the path through the meeting cell, from goal to start
+     * @param meetIdx - index in padded_ of the cell both searches reached
+     * @param startIdx - index of the start cell in padded_
+     * @param goalIdx - index of the goal cell in padded_
+     * @param cost - cost of the path
+     * @param path - receives the path from goal to start
+     * @return void
+     */
+    void convertParents2Path(const int64_t meetIdx, const int64_t startIdx, const int64_t goalIdx,
+                             const double cost, std::vector<Node_C>& path);
+};
+
+/** \brief bidirectional A* moving to the 4 edge neighbours */
+using BiAStar_C = BasicBiAStar_C<FourConnected_S, Manhattan_S>;
+/** \brief bidirectional A* moving to the 8 edge and corner neighbours */
+using BiAStar8_C = BasicBiAStar_C<EightConnected_S, Octile_S>;
+/** \brief bidirectional Dijkstra moving to the 4 edge neighbours */
+using BiDijkstra_C = BasicBiAStar_C<FourConnected_S, Zero_S>;
+
+extern template class BasicBiAStar_C<FourConnected_S, Manhattan_S>;
+extern template class BasicBiAStar_C<EightConnected_S, Octile_S>;
+extern template class BasicBiAStar_C<FourConnected_S, Zero_S>;
+
+} // namespace planning
+
+#endif /* BIASTAR_H_ */
@@ -0,0 +1,217 @@
+/**
+ * @file distance_field.cpp
+ * @author osamy
+ * @brief contains the distance field class implementation
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "distance_field.hpp"
+
+namespace
+{
+constexpr double inf = std::numeric_limits<double>::infinity();
+/** \brief number of buckets of the weighted sweep, above the largest cell cost */
+constexpr size_t num_buckets = 256;
+} // namespace
+
+bool planning::DistanceField_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    stats_ = SearchStats_S();
+    PLANNER_STATS_TIMER(stats_, wallNs);
+    path.clear();
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+
+    const int64_t startIdx = padded_.index(start.x_ + 1, start.y_ + 1);
+    const int64_t goalIdx = padded_.index(goal.x_ + 1, goal.y_ + 1);
+    const field_S& f = field(startIdx);
+    if (std::isinf(f.cost[goalIdx]))
+    {
+        return false;
+    }
+
+    PLANNER_STATS_TIMER(stats_, reconstructionNs);
+    const int64_t stride = padded_.cols();
+    /* id of a cell in the map from its index in padded_ */
+    const auto toId = [this, stride](const int64_t idx) { return (idx / stride - 1) * cols_ + idx % stride - 1; };
+    int64_t cur = goalIdx;
+    while (cur != startIdx)
+    {
+        const int64_t pIdx = cur - offsets_[f.move[cur]];
+        path.emplace_back(cur / stride - 1, cur % stride - 1, f.cost[cur], 0, toId(cur), toId(pIdx));
+        cur = pIdx;
+    }
+    path.emplace_back(start.x_, start.y_, 0, 0, toId(startIdx), toId(startIdx));
+    return true;
+}
+
+double planning::DistanceField_C::distance(const Node_C& start, const Node_C& goal)
+{
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return inf;
+    }
+    return field(padded_.index(start.x_ + 1, start.y_ + 1)).cost[padded_.index(goal.x_ + 1, goal.y_ + 1)];
+}
+
+void planning::DistanceField_C::updateCells(const std::vector<Node_C>& cells, const uint8_t value)
+{
+    bool changed = false;
+    for (const auto& c : cells)
+    {
+        if (checkOutsideBoundary(c, rows_, cols_))
+        {
+            continue;
+        }
+        uint8_t& cell = padded_(c.x_ + 1, c.y_ + 1);
+        if (cell == value)
+        {
+            continue;
+        }
+        numWeighted_ += static_cast<int64_t>(value > 1) - static_cast<int64_t>(cell > 1);
+        cell = value;
+        changed = true;
+    }
+    if (changed)
+    {
+        mapVersion_++;
+    }
+}
+
+void planning::DistanceField_C::pad()
+{
+    padded_ = padGrid(*map_, 1, static_cast<uint8_t>(1));
+    for (int m = 0; m < FourConnected_S::connectivity; m++)
+    {
+        offsets_[m] = FourConnected_S::dx[m] * padded_.cols() + FourConnected_S::dy[m];
+    }
+    const uint8_t* const cells = padded_.data();
+    numWeighted_ = std::count_if(cells, cells + padded_.numCells(), [](const uint8_t v) { return v > 1; });
+}
+
+const planning::DistanceField_C::field_S& planning::DistanceField_C::field(const int64_t startIdx)
+{
+    useCount_++;
+    auto it = std::find_if(fields_.begin(), fields_.end(), [startIdx](const field_S& f) { return f.startIdx == startIdx; });
+    if (it == fields_.end())
+    {
+        if (fields_.size() < maxFields_)
+        {
+            it = fields_.emplace(fields_.end());
+        }
+        else
+        {
+            /* reuse the least recently used field, and its buffers */
+            it = std::min_element(fields_.begin(), fields_.end(),
+                                  [](const field_S& a, const field_S& b) { return a.lastUse < b.lastUse; });
+        }
+        it->startIdx = startIdx;
+        it->mapVersion = mapVersion_ - 1;
+    }
+    it->lastUse = useCount_;
+
+    if (it->mapVersion != mapVersion_)
+    {
+        it->mapVersion = mapVersion_;
+        it->cost.assign(static_cast<size_t>(padded_.numCells()), inf);
+        it->move.assign(static_cast<size_t>(padded_.numCells()), no_move);
+        it->cost[startIdx] = 0;
+        if (0 == numWeighted_)
+        {
+            sweepUniform(*it);
+        }
+        else
+        {
+            sweepWeighted(*it);
+        }
+    }
+    return *it;
+}
+
+void planning::DistanceField_C::sweepUniform(field_S& f)
+{
+    PLANNER_STATS_TIMER(stats_, neighbourNs);
+    const uint8_t* const cells = padded_.data();
+    double* const cost = f.cost.data();
+    uint8_t* const move = f.move.data();
+    /* cells are queued once, when first reached, and every step costs 1, so
+     * the queue is in order of cost and the first cost of a cell is its best */
+    buckets_.resize(1);
+    std::vector<int64_t>& queue = buckets_.front();
+    queue.clear();
+    queue.push_back(f.startIdx);
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        const int64_t cur = queue[head];
+        const double c = cost[cur] + 1;
+        PLANNER_STATS_ADD(stats_, expanded, 1);
+        for (int m = 0; m < FourConnected_S::connectivity; m++)
+        {
+            /* the border is made of obstacles, so no neighbour is ever outside padded_ */
+            const int64_t nIdx = cur + offsets_[m];
+            if (!isTraversable(cells[nIdx]) || !std::isinf(cost[nIdx]))
+            {
+                continue;
+            }
+            cost[nIdx] = c;
+            move[nIdx] = static_cast<uint8_t>(m);
+            queue.push_back(nIdx);
+        }
+    }
+    PLANNER_STATS_ADD(stats_, pushed, queue.size());
+    PLANNER_STATS_MAX(stats_, maxOpenSize, queue.size());
+}
+
+void planning::DistanceField_C::sweepWeighted(field_S& f)
+{
+    PLANNER_STATS_TIMER(stats_, neighbourNs);
+    const uint8_t* const cells = padded_.data();
+    double* const cost = f.cost.data();
+    uint8_t* const move = f.move.data();
+    /* a cell of cost c sits in bucket c % num_buckets. every step costs less
+     * than num_buckets, so the buckets ahead of the current one never hold
+     * two different costs, and costs are integers so they are exact */
+    buckets_.resize(num_buckets);
+    for (auto& b : buckets_)
+    {
+        b.clear();
+    }
+    buckets_[0].push_back(f.startIdx);
+    size_t numQueued = 1;
+    PLANNER_STATS_ADD(stats_, pushed, 1);
+    for (uint64_t current = 0; numQueued > 0; current++)
+    {
+        std::vector<int64_t>& bucket = buckets_[current % num_buckets];
+        /* the steps out of this bucket cost at least 1, so it does not grow */
+        for (const int64_t cur : bucket)
+        {
+            if (cost[cur] != static_cast<double>(current))
+            {
+                /* queued again since at a lower cost, already expanded */
+                continue;
+            }
+            PLANNER_STATS_ADD(stats_, expanded, 1);
+            for (int m = 0; m < FourConnected_S::connectivity; m++)
+            {
+                const int64_t nIdx = cur + offsets_[m];
+                const double c = cost[cur] + cellCost(cells[nIdx]);
+                if (c < cost[nIdx])
+                {
+                    cost[nIdx] = c;
+                    move[nIdx] = static_cast<uint8_t>(m);
+                    buckets_[static_cast<uint64_t>(c) % num_buckets].push_back(nIdx);
+                    numQueued++;
+                    PLANNER_STATS_ADD(stats_, pushed, 1);
+                }
+            }
+        }
+        numQueued -= bucket.size();
+        bucket.clear();
+        PLANNER_STATS_MAX(stats_, maxOpenSize, numQueued);
+    }
+}
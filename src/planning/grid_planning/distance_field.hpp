@@ -0,0 +1,148 @@
+/**
+ * @file distance_field.hpp
+ * @author osamy
+ * @brief one-to-all distance field planner class
+ */
+
+#ifndef DISTANCE_FIELD_H_
+#define DISTANCE_FIELD_H_
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for answering many queries from the same start with one cached sweep of the map
+ */
+class DistanceField_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @param maxFields - number of starts whose fields are kept, at least 1
+     * @return none
+     */
+    explicit DistanceField_C(OccupancyGrid_C grid, const size_t maxFields = 1)
+                : GPEngine_C(std::move(grid)), maxFields_(std::max<size_t>(1, maxFields)) { pad(); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @param maxFields - number of starts whose fields are kept, at least 1
+     * @return none
+     */
+    explicit DistanceField_C(std::shared_ptr<const OccupancyGrid_C> map, const size_t maxFields = 1)
+                : GPEngine_C(std::move(map)), maxFields_(std::max<size_t>(1, maxFields)) { pad(); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details sweeps the map from the start unless its field is cached
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief cost of the cheapest path between two cells
+     * @param start - start node
+     * @param goal - goal node
+     * @return cost, infinity if there is no path or a node is outside the map
+     * @details sweeps the map from the start unless its field is cached
+     */
+    double distance(const Node_C& start, const Node_C& goal);
+
+    /**
+     * @brief changes cells of the planner's copy of the map
+     * @param cells - cells to be changed, only their coordinates are used
+     * @param value - new value of the cells
+     * @return void
+     * @details advances the map version if any cell changed, which makes
+     * every cached field stale
+     */
+    void updateCells(const std::vector<Node_C>& cells, const uint8_t value) override;
+
+    /**
+     * @brief returns the version of the planner's copy of the map
+     * @return number of calls to updateCells() that changed a cell
+     */
+    uint64_t getMapVersion() const { return mapVersion_; }
+
+private:
+    /**
+     * @brief costs from one start to every cell of padded_
+     */
+    struct field_S
+    {
+        /** \brief index in padded_ of the start */
+        int64_t startIdx = -1;
+        /** \brief map version the field was swept for */
+        uint64_t mapVersion = 0;
+        /** \brief value of useCount_ when the field was last used */
+        uint64_t lastUse = 0;
+        /** \brief cost from the start to each cell, infinity if it cannot be reached */
+        std::vector<double> cost;
+        /** \brief index in offsets_ of the move into each cell, no_move for the start and unreached cells */
+        std::vector<uint8_t> move;
+    };
+
+    /** \brief move of the cells that were not entered from a neighbour */
+    static constexpr uint8_t no_move = 0xFF;
+
+    /** \brief the map with a border of obstacles around it, including the changes */
+    OccupancyGrid_C padded_;
+    /** \brief index offset of the neighbour reached by each motion in padded_ */
+    std::array<int64_t, FourConnected_S::connectivity> offsets_{};
+    /** \brief number of cells of padded_ that are neither free nor obstacles */
+    int64_t numWeighted_ = 0;
+    /** \brief version of padded_, see getMapVersion() */
+    uint64_t mapVersion_ = 0;
+    /** \brief number of fields kept */
+    size_t maxFields_;
+    /** \brief cached fields, at most maxFields_ */
+    std::vector<field_S> fields_;
+    /** \brief counts the uses of fields, orders them for eviction */
+    uint64_t useCount_ = 0;
+    /** \brief queue of the sweeps, one bucket per cost modulo 256 for weighted maps */
+    std::vector<std::vector<int64_t>> buckets_;
+
+    /**
+     * @brief builds padded_, offsets_ and numWeighted_ from the map
+     * @return void
+     */
+    void pad();
+
+    /**
+     * @brief returns the up to date field of a start, sweeping it if needed
+     * @param startIdx - index of the start in padded_
+     * @return field of the start
+     */
+    const field_S& field(const int64_t startIdx);
+
+    /**
+     * @brief fills a field with a breadth first search, for maps without weighted cells
+     * @param f - field whose startIdx is set, cost and move are overwritten
+     * @return void
+     */
+    void sweepUniform(field_S& f);
+
+    /**
+     * @brief fills a field with a bucket queue ordered by cost
+     * @param f - field whose startIdx is set, cost and move are overwritten
+     * @return void
+     */
+    void sweepWeighted(field_S& f);
+};
+
+} // namespace planning
+
+#endif /* DISTANCE_FIELD_H_ */
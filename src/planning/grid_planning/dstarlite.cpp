@@ -0,0 +1,264 @@
+/**
+ * @file dstarlite.cpp
+ * @author osamy
+ * @brief contains the D* Lite class implementation
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "dstarlite.hpp"
+
+namespace
+{
+constexpr double inf = std::numeric_limits<double>::infinity();
+} // namespace
+
+bool planning::DStarLite_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    stats_ = SearchStats_S();
+    PLANNER_STATS_TIMER(stats_, wallNs);
+    path.clear();
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+
+    start_ = makeNode(start.x_, start.y_);
+    if (!initialized_ || !compareCoordinates(goal, goal_))
+    {
+        goal_ = makeNode(goal.x_, goal.y_);
+        initialize();
+    }
+    else
+    {
+        /* the start moved since the last call, keep the queue and shift the keys */
+        km_ += heuristic(last_, start_);
+        last_ = start_;
+    }
+    computeShortestPath();
+
+    /* path is built from start to goal, and returned from goal to start,
+     * the repairs on the way are timed as part of the reconstruction */
+    PLANNER_STATS_TIMER(stats_, reconstructionNs);
+    Node_C cur = start_;
+    double travelled = 0;
+    path.emplace_back(cur.x_, cur.y_, 0, 0, cur.id_, cur.id_);
+
+    for (int64_t t = 0; !compareCoordinates(cur, goal_); t++)
+    {
+        if (const auto changed = discoverObstacles(t, cur); !changed.empty())
+        {
+            km_ += heuristic(last_, cur);
+            last_ = cur;
+            for (const auto& c : changed)
+            {
+                updateVertex(c);
+                for (const auto& m : motions_)
+                {
+                    const Node_C p = makeNode(c.x_ + m.x_, c.y_ + m.y_);
+                    if (!checkOutsideBoundary(p, rows_, cols_))
+                    {
+                        updateVertex(p);
+                    }
+                }
+            }
+            start_ = cur;
+            computeShortestPath();
+        }
+
+        if (std::isinf(g_[cur.id_]))
+        {
+            std::reverse(path.begin(), path.end());
+            return false;
+        }
+
+        /* move to the successor minimising c(cur, s') + g(s') */
+        double best = inf;
+        Node_C next = cur;
+        double stepCost = 0;
+        for (const auto& m : motions_)
+        {
+            const Node_C s = makeNode(cur.x_ + m.x_, cur.y_ + m.y_);
+            if (checkOutsideBoundary(s, rows_, cols_))
+            {
+                continue;
+            }
+            const double c = edgeCost(cur, s, m.cost_);
+            if (c + g_[s.id_] < best)
+            {
+                best = c + g_[s.id_];
+                next = s;
+                stepCost = c;
+            }
+        }
+        if (std::isinf(best))
+        {
+            std::reverse(path.begin(), path.end());
+            return false;
+        }
+
+        travelled += stepCost;
+        path.emplace_back(next.x_, next.y_, travelled, 0, next.id_, cur.id_);
+        cur = next;
+        start_ = cur;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+void planning::DStarLite_C::setDynamicObstacles(const bool createRandObst,
+                                                const std::unordered_map<int64_t, std::vector<Node_C>>& timeDiscObst)
+{
+    createRandObst_ = createRandObst;
+    timeDiscObst_ = timeDiscObst;
+}
+
+void planning::DStarLite_C::initialize()
+{
+    const auto numCells = static_cast<size_t>(grid_.numCells());
+    g_.assign(numCells, inf);
+    rhs_.assign(numCells, inf);
+    U_.clear();
+    km_ = 0;
+    last_ = start_;
+    rhs_[goal_.id_] = 0;
+    U_.insert({goal_, calculateKey(goal_)});
+    PLANNER_STATS_ADD(stats_, pushed, 1);
+    PLANNER_STATS_MAX(stats_, maxOpenSize, U_.size());
+    initialized_ = true;
+}
+
+double planning::DStarLite_C::heuristic(const Node_C& a, const Node_C& b)
+{
+    PLANNER_STATS_TIMER(stats_, heuristicNs);
+    return static_cast<double>(std::abs(a.x_ - b.x_) + std::abs(a.y_ - b.y_));
+}
+
+key_S planning::DStarLite_C::calculateKey(const Node_C& s)
+{
+    const double m = std::min(g_[s.id_], rhs_[s.id_]);
+    return {m + heuristic(start_, s) + km_, m};
+}
+
+double planning::DStarLite_C::edgeCost(const Node_C& a, const Node_C& b, const double motionCost) const
+{
+    if (0 != grid_(a.x_, a.y_) || 0 != grid_(b.x_, b.y_))
+    {
+        return inf;
+    }
+    return motionCost;
+}
+
+void planning::DStarLite_C::updateVertex(const Node_C& u)
+{
+    if (!compareCoordinates(u, goal_))
+    {
+        double best = inf;
+        for (const auto& m : motions_)
+        {
+            const Node_C s = makeNode(u.x_ + m.x_, u.y_ + m.y_);
+            if (!checkOutsideBoundary(s, rows_, cols_))
+            {
+                best = std::min(best, edgeCost(u, s, m.cost_) + g_[s.id_]);
+            }
+        }
+        rhs_[u.id_] = best;
+    }
+
+    const node_key_pair_S nkp{u, {}};
+    PLANNER_STATS_ADD(stats_, duplicatePushes, (g_[u.id_] != rhs_[u.id_]) && U_.isElementInStruct(nkp));
+    U_.remove(nkp);
+    if (g_[u.id_] != rhs_[u.id_])
+    {
+        U_.insert({u, calculateKey(u)});
+        PLANNER_STATS_ADD(stats_, pushed, 1);
+        PLANNER_STATS_MAX(stats_, maxOpenSize, U_.size());
+    }
+}
+
+void planning::DStarLite_C::computeShortestPath()
+{
+    while (!U_.empty() &&
+           (U_.top().key < calculateKey(start_) || rhs_[start_.id_] != g_[start_.id_]))
+    {
+        const node_key_pair_S top = U_.top();
+        const Node_C u = top.node;
+        const key_S kNew = calculateKey(u);
+        U_.pop();
+
+        if (top.key < kNew)
+        {
+            U_.insert({u, kNew});
+            PLANNER_STATS_ADD(stats_, pushed, 1);
+            continue;
+        }
+
+        PLANNER_STATS_ADD(stats_, expanded, 1);
+        PLANNER_STATS_TIMER(stats_, neighbourNs);
+        if (g_[u.id_] > rhs_[u.id_])
+        {
+            g_[u.id_] = rhs_[u.id_];
+            for (const auto& m : motions_)
+            {
+                const Node_C p = makeNode(u.x_ + m.x_, u.y_ + m.y_);
+                if (!checkOutsideBoundary(p, rows_, cols_))
+                {
+                    updateVertex(p);
+                }
+            }
+        }
+        else
+        {
+            g_[u.id_] = inf;
+            updateVertex(u);
+            for (const auto& m : motions_)
+            {
+                const Node_C p = makeNode(u.x_ + m.x_, u.y_ + m.y_);
+                if (!checkOutsideBoundary(p, rows_, cols_))
+                {
+                    updateVertex(p);
+                }
+            }
+        }
+    }
+}
+
+std::vector<Node_C> planning::DStarLite_C::discoverObstacles(const int64_t t, const Node_C& cur)
+{
+    std::vector<Node_C> changed;
+    const auto markObstacle = [&](const int64_t x, const int64_t y) {
+        const Node_C c = makeNode(x, y);
+        if (checkOutsideBoundary(c, rows_, cols_) || compareCoordinates(c, cur)
+            || compareCoordinates(c, goal_) || 0 != grid_(x, y))
+        {
+            return;
+        }
+        grid_(x, y) = 1;
+        changed.push_back(c);
+    };
+
+    if (const auto it = timeDiscObst_.find(t); it != timeDiscObst_.end())
+    {
+        for (const auto& o : it->second)
+        {
+            markObstacle(o.x_, o.y_);
+        }
+    }
+    if (createRandObst_)
+    {
+        /* on average one new obstacle every rows steps, as for makeGrid */
+        std::uniform_int_distribution<int64_t> row(0, rows_ - 1);
+        std::uniform_int_distribution<int64_t> col(0, cols_ - 1);
+        if (0 == row(rng_))
+        {
+            const int64_t x = row(rng_);
+            markObstacle(x, col(rng_));
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file dstarlite.hpp
+ * @author osamy
+ * @brief D* Lite planner class
+ */
+
+#ifndef DSTARLITE_H_
+#define DSTARLITE_H_
+
+#include <random>
+
+#include "grid_engine.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the D* Lite algorithm
+ */
+class DStarLite_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @return none
+     */
+    explicit DStarLite_C(OccupancyGrid_C grid)
+                : GPEngine_C(std::move(grid)), grid_(*map_) {}
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @return none
+     */
+    explicit DStarLite_C(std::shared_ptr<const OccupancyGrid_C> map)
+                : GPEngine_C(std::move(map)), grid_(*map_) {}
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path travelled from goal to start
+     * @return bool whether the goal was reached
+     * @details moves from start to goal one cell per time step, discovering
+     * obstacles and replanning on the way. a call with the same goal as the
+     * previous one reuses the previous search.
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief sets the time discovered obstacles and flag to create random ones
+     * @param createRandObst - should random obstacles be created during execution
+     * @param timeDiscObst - obstacles to be discovered at specific times
+     * @return void
+     * @details the time is the number of steps taken since the start of plan()
+     */
+    void setDynamicObstacles(const bool createRandObst = false,
+                             const std::unordered_map<int64_t, std::vector<Node_C>>& timeDiscObst = {}) override;
+
+    /**
+     * @brief returns the map as currently known to the planner
+     * @return grid with the discovered obstacles
+     */
+    const OccupancyGrid_C& getKnownGrid() const { return grid_; }
+
+private:
+    /** \brief map including the obstacles discovered so far */
+    OccupancyGrid_C grid_;
+    /** \brief cost-to-goal of each cell */
+    std::vector<double> g_;
+    /** \brief one step lookahead cost-to-goal of each cell */
+    std::vector<double> rhs_;
+    /** \brief queue of inconsistent cells */
+    PrioQ_C U_;
+    /** \brief key modifier, accumulates the heuristic change as the start moves */
+    double km_ = 0;
+    /** \brief start at the time of the last key modifier update */
+    Node_C last_;
+    /** \brief current start */
+    Node_C start_;
+    /** \brief goal the search state belongs to */
+    Node_C goal_;
+    /** \brief whether the search state is valid */
+    bool initialized_ = false;
+    /** \brief permissible motions */
+    const std::vector<Node_C> motions_ = getPermissibleMotion();
+    /** \brief should random obstacles be created during execution */
+    bool createRandObst_ = false;
+    /** \brief obstacles to be discovered at specific time steps */
+    std::unordered_map<int64_t, std::vector<Node_C>> timeDiscObst_;
+    /** \brief generator for the random obstacles */
+    std::mt19937 rng_;
+
+    /**
+     * @brief resets the search state for a new goal
+     * @return void
+     */
+    void initialize();
+
+    /**
+     * @brief heuristic distance between two cells
+     * @param a - first cell
+     * @param b - second cell
+     * @return manhattan distance
+     * @details not const, records its time in the statistics
+     */
+    double heuristic(const Node_C& a, const Node_C& b);
+
+    /**
+     * @brief key of a cell
+     * @param s - cell
+     * @return priority of the cell in U_
+     */
+    key_S calculateKey(const Node_C& s);
+
+    /**
+     * @brief cost of moving between two neighbouring cells
+     * @param a - first cell
+     * @param b - second cell
+     * @param motionCost - cost of the motion
+     * @return motion cost, infinity if either cell is an obstacle
+     */
+    double edgeCost(const Node_C& a, const Node_C& b, const double motionCost) const;
+
+    /**
+     * @brief recomputes the rhs value of a cell and its membership in U_
+     * @param u - cell
+     * @return void
+     */
+    void updateVertex(const Node_C& u);
+
+    /**
+     * @brief expands inconsistent cells until the start is consistent
+     * @return void
+     */
+    void computeShortestPath();
+
+    /**
+     * @brief writes the obstacles discovered at a time step into the map
+     * @param t - time step
+     * @param cur - current position, never turned into an obstacle
+     * @return cells that turned into obstacles
+     */
+    std::vector<Node_C> discoverObstacles(const int64_t t, const Node_C& cur);
+
+    /**
+     * @brief creates a node for a cell
+     * @param x - row
+     * @param y - column
+     * @return node with its id set
+     */
+    Node_C makeNode(const int64_t x, const int64_t y) const { return Node_C(x, y, 0, 0, x * cols_ + y, x * cols_ + y); }
+};
+
+} // namespace planning
+
+#endif /* DSTARLITE_H_ */
@@ -0,0 +1,554 @@
+/**
+ * @file hpa.cpp
+ * @author osamy
+ * @brief contains the HPA* class implementation
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "hpa.hpp"
+#include "thread_pool.hpp"
+
+/* a border of L cells has at most ceil(L / 2) entrances: every run of free
+ * cells but the last is followed by a blocked one, and a run gets two or
+ * three entrances only from 6 cells on */
+planning::HPA_C::HPA_C(OccupancyGrid_C grid, const int64_t clusterSize)
+            : GPEngine_C(std::move(grid)), grid_(*map_), clusterSize_(std::max<int64_t>(clusterSize, 1)),
+              numClusterRows_((rows_ + clusterSize_ - 1) / clusterSize_),
+              numClusterCols_((cols_ + clusterSize_ - 1) / clusterSize_), nodeStride_(4 * ((clusterSize_ + 1) / 2)),
+              clusters_(numClusterRows_ * numClusterCols_)
+{
+    build();
+}
+
+planning::HPA_C::HPA_C(std::shared_ptr<const OccupancyGrid_C> map, const int64_t clusterSize)
+            : GPEngine_C(std::move(map)), grid_(*map_), clusterSize_(std::max<int64_t>(clusterSize, 1)),
+              numClusterRows_((rows_ + clusterSize_ - 1) / clusterSize_),
+              numClusterCols_((cols_ + clusterSize_ - 1) / clusterSize_), nodeStride_(4 * ((clusterSize_ + 1) / 2)),
+              clusters_(numClusterRows_ * numClusterCols_)
+{
+    build();
+}
+
+bool planning::HPA_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    stats_ = SearchStats_S();
+    PLANNER_STATS_TIMER(stats_, wallNs);
+    path.clear();
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+    const int64_t startCell = grid_.index(start.x_, start.y_);
+    const int64_t goalCell = grid_.index(goal.x_, goal.y_);
+    if (!isTraversable(grid_[startCell]) || !isTraversable(grid_[goalCell]))
+    {
+        return false;
+    }
+    if (startCell == goalCell)
+    {
+        refined_.assign(1, startCell);
+        buildPath(path);
+        return true;
+    }
+
+    /* start and goal join the abstract graph as two extra nodes */
+    const int64_t startId = static_cast<int64_t>(clusters_.size()) * nodeStride_;
+    const int64_t goalId = startId + 1;
+    const int64_t startCluster = clusterOf(startCell);
+    const int64_t goalCluster = clusterOf(goalCell);
+    const cluster_S& sc = clusters_[startCluster];
+    const cluster_S& gc = clusters_[goalCluster];
+    const rect_S sr = rect(startCluster);
+    const rect_S gr = rect(goalCluster);
+
+    clusterSearch(gr, goalCell, true, -1, localCtx_);
+    PLANNER_STATS_ADD(stats_, expanded, localCtx_.stats().expanded);
+    goalEdges_.resize(gc.nodes.size());
+    for (size_t j = 0; j < gc.nodes.size(); j++)
+    {
+        goalEdges_[j] = localCtx_.cost(localIndex(gr, gc.nodes[j].cell));
+    }
+    clusterSearch(sr, startCell, false, -1, localCtx_);
+    PLANNER_STATS_ADD(stats_, expanded, localCtx_.stats().expanded);
+    startEdges_.resize(sc.nodes.size());
+    for (size_t j = 0; j < sc.nodes.size(); j++)
+    {
+        startEdges_[j] = localCtx_.cost(localIndex(sr, sc.nodes[j].cell));
+    }
+
+    /* across a border the abstract graph only knows the entrances, which can
+     * send a goal next door around them; a search over both clusters is one
+     * more edge from start to goal. it is the last use of localCtx_ before the
+     * path is refined, which then reuses it */
+    const bool near = std::abs(startCluster / numClusterCols_ - goalCluster / numClusterCols_) <= 1
+                      && std::abs(startCluster % numClusterCols_ - goalCluster % numClusterCols_) <= 1;
+    const rect_S local = span(startCluster, goalCluster);
+    double direct = std::numeric_limits<double>::infinity();
+    if (near)
+    {
+        clusterSearch(local, startCell, false, goalCell, localCtx_);
+        PLANNER_STATS_ADD(stats_, expanded, localCtx_.stats().expanded);
+        direct = localCtx_.cost(localIndex(local, goalCell));
+    }
+
+    const int64_t goalX = goal.x_;
+    const int64_t goalY = goal.y_;
+    const auto heuristic = [this, goalX, goalY](const int64_t cell) {
+        return Manhattan_S()(cell / cols_ - goalX, cell % cols_ - goalY);
+    };
+
+    absCtx_.reset(goalId + 1);
+    IndexedHeap_C<open_key_S>& oList = absCtx_.open();
+    const double startH = heuristic(startCell);
+    absCtx_.setCost(startId, 0, startId);
+    oList.push(startId, {startH, startH});
+    PLANNER_STATS_ADD(stats_, pushed, 1);
+    PLANNER_STATS_MAX(stats_, maxOpenSize, 1);
+
+    const auto relax = [this, &oList, goalId, &heuristic](const int64_t from, const int64_t to, const double g) {
+        if (g < absCtx_.cost(to) && !absCtx_.isClosed(to))
+        {
+            const double h = (goalId == to) ? 0 : heuristic(nodeCell(to));
+            absCtx_.setCost(to, g, from);
+            PLANNER_STATS_ADD(stats_, duplicatePushes, oList.contains(to));
+            oList.push(to, {g + h, h});
+            PLANNER_STATS_ADD(stats_, pushed, 1);
+            PLANNER_STATS_MAX(stats_, maxOpenSize, oList.size());
+        }
+    };
+
+    bool found = false;
+    while (!oList.empty())
+    {
+        const int64_t cur = oList.top();
+        oList.pop();
+        absCtx_.setClosed(cur);
+        PLANNER_STATS_ADD(stats_, expanded, 1);
+        if (goalId == cur)
+        {
+            found = true;
+            break;
+        }
+        const double g = absCtx_.cost(cur);
+
+        PLANNER_STATS_TIMER(stats_, neighbourNs);
+        if (startId == cur)
+        {
+            for (size_t j = 0; j < sc.nodes.size(); j++)
+            {
+                relax(cur, startCluster * nodeStride_ + static_cast<int64_t>(j), startEdges_[j]);
+            }
+            relax(cur, goalId, direct);
+            continue;
+        }
+
+        const int64_t c = cur / nodeStride_;
+        const size_t i = static_cast<size_t>(cur % nodeStride_);
+        const cluster_S& cluster = clusters_[c];
+        const size_t k = cluster.nodes.size();
+        for (size_t j = 0; j < k; j++)
+        {
+            relax(cur, c * nodeStride_ + static_cast<int64_t>(j), g + cluster.dist[i * k + j]);
+        }
+        const entrance_S& e = cluster.nodes[i];
+        for (int p = 0; p < e.numPartners; p++)
+        {
+            relax(cur, e.partnerIds[p], g + cellCost(grid_[e.partners[p]]));
+        }
+        if (goalCluster == c)
+        {
+            relax(cur, goalId, g + goalEdges_[i]);
+        }
+    }
+    if (!found)
+    {
+        return false;
+    }
+
+    PLANNER_STATS_TIMER(stats_, reconstructionNs);
+    if (startId == absCtx_.parent(goalId))
+    {
+        /* no route through the entrances beat the search over both clusters */
+        refined_.assign(1, startCell);
+        appendSegment(local, startCell, goalCell);
+    }
+    else
+    {
+        abstractPath_.assign(1, goalCell);
+        for (int64_t cur = absCtx_.parent(goalId); cur != startId; cur = absCtx_.parent(cur))
+        {
+            abstractPath_.push_back(nodeCell(cur));
+        }
+        abstractPath_.push_back(startCell);
+        std::reverse(abstractPath_.begin(), abstractPath_.end());
+        refinePath();
+    }
+    buildPath(path);
+    return true;
+}
+
+void planning::HPA_C::updateCells(const std::vector<Node_C>& cells, const uint8_t value)
+{
+    std::vector<bool> dirty(clusters_.size(), false);
+    for (const Node_C& node : cells)
+    {
+        if (checkOutsideBoundary(node, rows_, cols_))
+        {
+            continue;
+        }
+        grid_(node.x_, node.y_) = value;
+        /* a cell on the border of its cluster also changes the entrances of the
+         * cluster next to it */
+        const int64_t cx = node.x_ / clusterSize_;
+        const int64_t cy = node.y_ / clusterSize_;
+        dirty[cx * numClusterCols_ + cy] = true;
+        if (0 == node.x_ % clusterSize_ && cx > 0)
+        {
+            dirty[(cx - 1) * numClusterCols_ + cy] = true;
+        }
+        if (clusterSize_ - 1 == node.x_ % clusterSize_ && cx + 1 < numClusterRows_)
+        {
+            dirty[(cx + 1) * numClusterCols_ + cy] = true;
+        }
+        if (0 == node.y_ % clusterSize_ && cy > 0)
+        {
+            dirty[cx * numClusterCols_ + cy - 1] = true;
+        }
+        if (clusterSize_ - 1 == node.y_ % clusterSize_ && cy + 1 < numClusterCols_)
+        {
+            dirty[cx * numClusterCols_ + cy + 1] = true;
+        }
+    }
+    std::vector<int64_t> ids;
+    for (size_t c = 0; c < dirty.size(); c++)
+    {
+        if (dirty[c])
+        {
+            ids.push_back(static_cast<int64_t>(c));
+        }
+    }
+    buildClusters(ids);
+}
+
+int64_t planning::HPA_C::numAbstractNodes() const
+{
+    int64_t num = 0;
+    for (const cluster_S& cluster : clusters_)
+    {
+        num += static_cast<int64_t>(cluster.nodes.size());
+    }
+    return num;
+}
+
+void planning::HPA_C::build()
+{
+    std::vector<int64_t> ids(clusters_.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    buildClusters(ids);
+
+    /* the query buffers are sized up front: a node is at most once on the
+     * abstract path, a cell at most once on a segment, which spans up to 2 x 2
+     * clusters, and a refined path longer than the map would have to cross itself */
+    const auto numNodes = static_cast<int64_t>(clusters_.size()) * nodeStride_;
+    const int64_t spanSide = std::min(2 * clusterSize_, std::max(rows_, cols_));
+    absCtx_.reset(numNodes + 2);
+    localCtx_.reset(spanSide * spanSide);
+    startEdges_.reserve(static_cast<size_t>(nodeStride_));
+    goalEdges_.reserve(static_cast<size_t>(nodeStride_));
+    abstractPath_.reserve(static_cast<size_t>(numNodes + 2));
+    segment_.reserve(static_cast<size_t>(spanSide * spanSide));
+    refined_.reserve(static_cast<size_t>(rows_ * cols_));
+}
+
+void planning::HPA_C::buildClusters(const std::vector<int64_t>& ids)
+{
+    /* below this many clusters, starting the threads costs more than it saves */
+    constexpr size_t minParallel = 64;
+
+    const size_t numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    if (ids.size() < minParallel || 1 == numThreads)
+    {
+        for (const int64_t c : ids)
+        {
+            buildCluster(c, localCtx_);
+        }
+    }
+    else
+    {
+        /* every iteration writes only its own cluster */
+        if (buildCtx_.size() < numThreads)
+        {
+            buildCtx_.resize(numThreads);
+        }
+        workers(numThreads).parallelFor(ids.size(), [&](const size_t i, const size_t worker) {
+            buildCluster(ids[i], buildCtx_[worker]);
+        });
+    }
+
+    /* the partners of the rebuilt clusters and of the clusters next to them
+     * may have moved */
+    std::vector<bool> relink(clusters_.size(), false);
+    for (const int64_t c : ids)
+    {
+        const int64_t cx = c / numClusterCols_;
+        const int64_t cy = c % numClusterCols_;
+        relink[c] = true;
+        relink[(cx > 0) ? c - numClusterCols_ : c] = true;
+        relink[(cx + 1 < numClusterRows_) ? c + numClusterCols_ : c] = true;
+        relink[(cy > 0) ? c - 1 : c] = true;
+        relink[(cy + 1 < numClusterCols_) ? c + 1 : c] = true;
+    }
+    for (size_t c = 0; c < relink.size(); c++)
+    {
+        if (relink[c])
+        {
+            linkCluster(static_cast<int64_t>(c));
+        }
+    }
+}
+
+void planning::HPA_C::buildCluster(const int64_t c, SearchContext_C& ctx)
+{
+    cluster_S& cluster = clusters_[c];
+    cluster.nodes.clear();
+    const rect_S r = rect(c);
+    if (r.x0 > 0)
+    {
+        addEntrances(cluster, grid_.index(r.x0, r.y0), grid_.index(r.x0 - 1, r.y0), 1, r.y1 - r.y0);
+    }
+    if (r.x1 < rows_)
+    {
+        addEntrances(cluster, grid_.index(r.x1 - 1, r.y0), grid_.index(r.x1, r.y0), 1, r.y1 - r.y0);
+    }
+    if (r.y0 > 0)
+    {
+        addEntrances(cluster, grid_.index(r.x0, r.y0), grid_.index(r.x0, r.y0 - 1), cols_, r.x1 - r.x0);
+    }
+    if (r.y1 < cols_)
+    {
+        addEntrances(cluster, grid_.index(r.x0, r.y1 - 1), grid_.index(r.x0, r.y1), cols_, r.x1 - r.x0);
+    }
+
+    const size_t k = cluster.nodes.size();
+    cluster.dist.assign(k * k, std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < k; i++)
+    {
+        clusterSearch(r, cluster.nodes[i].cell, false, -1, ctx);
+        for (size_t j = 0; j < k; j++)
+        {
+            cluster.dist[i * k + j] = ctx.cost(localIndex(r, cluster.nodes[j].cell));
+        }
+    }
+}
+
+void planning::HPA_C::linkCluster(const int64_t c)
+{
+    for (entrance_S& e : clusters_[c].nodes)
+    {
+        for (int p = 0; p < e.numPartners; p++)
+        {
+            const int64_t pc = clusterOf(e.partners[p]);
+            const auto& nodes = clusters_[pc].nodes;
+            const auto it = std::find_if(nodes.begin(), nodes.end(),
+                                         [&e, p](const entrance_S& o) { return o.cell == e.partners[p]; });
+            e.partnerIds[p] = pc * nodeStride_ + (it - nodes.begin());
+        }
+    }
+}
+
+void planning::HPA_C::addEntrances(cluster_S& cluster, const int64_t inner, const int64_t outer,
+                                   const int64_t step, const int64_t length) const
+{
+    /* a run shorter than this gets a single entrance */
+    constexpr int64_t maxSingleRun = 5;
+
+    const auto add = [&cluster, inner, outer, step](const int64_t pos) {
+        const int64_t cell = inner + pos * step;
+        const int64_t partner = outer + pos * step;
+        for (entrance_S& e : cluster.nodes)
+        {
+            if (e.cell == cell)
+            {
+                e.partners[e.numPartners++] = partner;
+                return;
+            }
+        }
+        cluster.nodes.push_back({cell, {partner, -1, -1, -1}, {-1, -1, -1, -1}, 1});
+    };
+    /* cost of crossing the border at a position, the same seen from both clusters */
+    const auto crossing = [this, inner, outer, step](const int64_t pos) {
+        return cellCost(grid_[inner + pos * step]) + cellCost(grid_[outer + pos * step]);
+    };
+    /* cheapest crossing in [first, last], the one nearest the middle on a tie */
+    const auto cheapest = [&crossing](const int64_t first, const int64_t last) {
+        const int64_t mid = first + (last - first) / 2;
+        int64_t best = mid;
+        for (int64_t pos = first; pos <= last; pos++)
+        {
+            if (crossing(pos) < crossing(best)
+                || (crossing(pos) == crossing(best) && std::abs(pos - mid) < std::abs(best - mid)))
+            {
+                best = pos;
+            }
+        }
+        return best;
+    };
+
+    int64_t runStart = -1;
+    for (int64_t pos = 0; pos <= length; pos++)
+    {
+        const bool passable = pos < length && isTraversable(grid_[inner + pos * step])
+                              && isTraversable(grid_[outer + pos * step]);
+        if (passable && runStart < 0)
+        {
+            runStart = pos;
+        }
+        else if (!passable && runStart >= 0)
+        {
+            if (pos - runStart <= maxSingleRun)
+            {
+                add(cheapest(runStart, pos - 1));
+            }
+            else
+            {
+                add(runStart);
+                add(pos - 1);
+                const int64_t inside = cheapest(runStart + 1, pos - 2);
+                if (crossing(inside) < std::min(crossing(runStart), crossing(pos - 1)))
+                {
+                    add(inside);
+                }
+            }
+            runStart = -1;
+        }
+    }
+}
+
+planning::HPA_C::rect_S planning::HPA_C::rect(const int64_t c) const
+{
+    const int64_t x0 = (c / numClusterCols_) * clusterSize_;
+    const int64_t y0 = (c % numClusterCols_) * clusterSize_;
+    return {x0, std::min(x0 + clusterSize_, rows_), y0, std::min(y0 + clusterSize_, cols_)};
+}
+
+planning::HPA_C::rect_S planning::HPA_C::span(const int64_t a, const int64_t b) const
+{
+    const rect_S ra = rect(a);
+    const rect_S rb = rect(b);
+    return {std::min(ra.x0, rb.x0), std::max(ra.x1, rb.x1), std::min(ra.y0, rb.y0), std::max(ra.y1, rb.y1)};
+}
+
+void planning::HPA_C::clusterSearch(const rect_S& r, const int64_t src, const bool reverse, const int64_t target,
+                                    SearchContext_C& ctx) const
+{
+    const int64_t width = r.y1 - r.y0;
+    const int64_t targetX = (target < 0) ? 0 : target / cols_;
+    const int64_t targetY = (target < 0) ? 0 : target % cols_;
+    const auto heuristic = [target, targetX, targetY](const int64_t x, const int64_t y) {
+        return (target < 0) ? 0.0 : Manhattan_S()(x - targetX, y - targetY);
+    };
+
+    ctx.reset((r.x1 - r.x0) * width);
+    IndexedHeap_C<open_key_S>& oList = ctx.open();
+    const int64_t srcIdx = localIndex(r, src);
+    const int64_t targetIdx = (target < 0) ? -1 : localIndex(r, target);
+    const double srcH = heuristic(src / cols_, src % cols_);
+    ctx.setCost(srcIdx, 0, srcIdx);
+    oList.push(srcIdx, {srcH, srcH});
+
+    while (!oList.empty())
+    {
+        const int64_t curIdx = oList.top();
+        oList.pop();
+        ctx.setClosed(curIdx);
+        PLANNER_STATS_ADD(ctx.stats(), expanded, 1);
+        if (curIdx == targetIdx)
+        {
+            return;
+        }
+        const int64_t x = r.x0 + curIdx / width;
+        const int64_t y = r.y0 + curIdx % width;
+        const double g = ctx.cost(curIdx);
+        /* backwards, the move is from the neighbour into the current cell */
+        const double curCost = cellCost(grid_(x, y));
+
+        for (int m = 0; m < FourConnected_S::connectivity; m++)
+        {
+            const int64_t nx = x + FourConnected_S::dx[m];
+            const int64_t ny = y + FourConnected_S::dy[m];
+            if (nx < r.x0 || nx >= r.x1 || ny < r.y0 || ny >= r.y1 || !isTraversable(grid_(nx, ny)))
+            {
+                continue;
+            }
+            const int64_t nIdx = curIdx + FourConnected_S::dx[m] * width + FourConnected_S::dy[m];
+            const double newG = g + (reverse ? curCost : cellCost(grid_(nx, ny)));
+            if (newG < ctx.cost(nIdx) && !ctx.isClosed(nIdx))
+            {
+                const double h = heuristic(nx, ny);
+                ctx.setCost(nIdx, newG, curIdx);
+                oList.push(nIdx, {newG + h, h});
+            }
+        }
+    }
+}
+
+void planning::HPA_C::refinePath()
+{
+    refined_.assign(1, abstractPath_.front());
+    for (size_t i = 1; i < abstractPath_.size(); i++)
+    {
+        const int64_t from = abstractPath_[i - 1];
+        const int64_t to = abstractPath_[i];
+        if (from == to)
+        {
+            continue;
+        }
+        const int64_t c = clusterOf(from);
+        if (clusterOf(to) != c)
+        {
+            /* crossing between the two cells of an entrance */
+            refined_.push_back(to);
+            continue;
+        }
+        const rect_S r = rect(c);
+        clusterSearch(r, from, false, to, localCtx_);
+        PLANNER_STATS_ADD(stats_, expanded, localCtx_.stats().expanded);
+        appendSegment(r, from, to);
+    }
+}
+
+void planning::HPA_C::appendSegment(const rect_S& r, const int64_t from, const int64_t to)
+{
+    const int64_t width = r.y1 - r.y0;
+    const int64_t fromIdx = localIndex(r, from);
+    segment_.clear();
+    for (int64_t idx = localIndex(r, to); idx != fromIdx; idx = localCtx_.parent(idx))
+    {
+        segment_.push_back((r.x0 + idx / width) * cols_ + r.y0 + idx % width);
+    }
+    refined_.insert(refined_.end(), segment_.rbegin(), segment_.rend());
+}
+
+void planning::HPA_C::buildPath(std::vector<Node_C>& path) const
+{
+
+    /* the cost of a cell is the cost of the path from the start up to it */
+    double cost = 0;
+    for (size_t i = 1; i < refined_.size(); i++)
+    {
+        cost += cellCost(grid_[refined_[i]]);
+    }
+    for (size_t i = refined_.size(); i-- > 0;)
+    {
+        const int64_t cell = refined_[i];
+        const int64_t pId = (i > 0) ? refined_[i - 1] : cell;
+        path.emplace_back(cell / cols_, cell % cols_, cost, 0, cell, pId);
+        cost -= cellCost(grid_[cell]);
+    }
+}
@@ -0,0 +1,292 @@
+/**
+ * @file hpa.hpp
+ * @author osamy
+ * @brief hierarchical path-finding A* (HPA*) planner class
+ */
+
+#ifndef HPA_H_
+#define HPA_H_
+
+#include <vector>
+
+#include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "search_context.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the HPA* algorithm
+ * @details the map is split into square clusters. where the free cells of two
+ * neighbouring clusters touch, each run of touching cells gets one entrance at
+ * its cheapest crossing (for runs of 6 cells or more, one at each end and one
+ * more where crossing is cheaper than at both ends). the cells on both sides of
+ * an entrance are the nodes of an abstract graph; the cost between every two
+ * nodes of a cluster, staying inside the cluster, is computed once when the
+ * planner is built, on all hardware threads.
+ * a query connects start and goal to the nodes of their clusters, runs A* on
+ * the abstract graph, and refines each abstract edge with a search inside a
+ * single cluster. when the clusters of start and goal are the same or touch,
+ * a search over both of them is one more route. the query cost depends on the
+ * number of clusters along the route rather than on the number of cells.
+ * the paths are close to, but not always, the shortest: away from the start
+ * and goal they only cross between clusters at entrances. on maps with cell
+ * costs above 1 they stray further from the shortest than on maps of free
+ * cells and obstacles only, an entrance being the cheapest crossing rather
+ * than the one on the cheapest route. unlike BasicAStar_C, a start on an
+ * obstacle has no path, the start could not be connected to the abstract graph.
+ * 4-connected, with the cell costs of cellCost(). the planner keeps its own
+ * copy of the map, which updateCells() changes; only the clusters touching the
+ * changed cells are rebuilt.
+ */
+class HPA_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief constructor, builds the abstract graph
+     * @param grid - grid map for the planning task
+     * @param clusterSize - side of a cluster in cells
+     * @return none
+     */
+    explicit HPA_C(OccupancyGrid_C grid, const int64_t clusterSize = 16);
+
+    /**
+     * @brief constructor, builds the abstract graph
+     * @param map - shared map for the planning task
+     * @param clusterSize - side of a cluster in cells
+     * @return none
+     */
+    explicit HPA_C(std::shared_ptr<const OccupancyGrid_C> map, const int64_t clusterSize = 16);
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details allocation-free once the search state and the path have grown
+     * to the largest query so far
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief changes cells of the planner's copy of the map and rebuilds the
+     * clusters they touch
+     * @param cells - cells to be changed, only their coordinates are used
+     * @param value - new value of the cells
+     * @return void
+     */
+    void updateCells(const std::vector<Node_C>& cells, const uint8_t value) override;
+
+    /**
+     * @brief returns the map as currently known to the planner
+     * @return grid with the changes made through updateCells()
+     */
+    const OccupancyGrid_C& getKnownGrid() const { return grid_; }
+
+    /**
+     * @brief number of nodes of the abstract graph
+     * @return number of entrance cells over all clusters
+     */
+    int64_t numAbstractNodes() const;
+
+private:
+    /**
+     * @brief an entrance cell of a cluster
+     */
+    struct entrance_S
+    {
+        /** \brief linear index of the cell in the map */
+        int64_t cell;
+        /** \brief cells across the cluster borders, one per border the cell is
+         * an entrance on, a cell is on up to 4 borders (with clusters of a single cell) */
+        int64_t partners[4];
+        /** \brief node ids of the partners, set by linkCluster() */
+        int64_t partnerIds[4];
+        /** \brief number of valid partners */
+        int numPartners;
+    };
+
+    /**
+     * @brief abstraction of a cluster
+     */
+    struct cluster_S
+    {
+        /** \brief entrance cells, in a fixed order */
+        std::vector<entrance_S> nodes;
+        /** \brief dist[i * nodes.size() + j] is the cost from node i to node j inside the cluster */
+        std::vector<double> dist;
+    };
+
+    /**
+     * @brief cells covered by a cluster, [x0, x1) x [y0, y1)
+     */
+    struct rect_S
+    {
+        int64_t x0;
+        int64_t x1;
+        int64_t y0;
+        int64_t y1;
+    };
+
+    /** \brief map including the changes made through updateCells() */
+    OccupancyGrid_C grid_;
+    /** \brief side of a cluster in cells */
+    const int64_t clusterSize_;
+    /** \brief number of rows of clusters */
+    const int64_t numClusterRows_;
+    /** \brief number of columns of clusters, cluster ids are row-major */
+    const int64_t numClusterCols_;
+    /** \brief largest number of entrances of a cluster, node i of cluster c has
+     * id c * nodeStride_ + i, so rebuilding a cluster leaves all other ids alone */
+    const int64_t nodeStride_;
+    /** \brief clusters, row-major */
+    std::vector<cluster_S> clusters_;
+    /** \brief cost from the start to every node of its cluster, for the current query */
+    std::vector<double> startEdges_;
+    /** \brief cost from every node of the goal's cluster to the goal, for the current query */
+    std::vector<double> goalEdges_;
+    /** \brief cells of the abstract path from start to goal, for the current query */
+    std::vector<int64_t> abstractPath_;
+    /** \brief cells of the refined path from start to goal, for the current query */
+    std::vector<int64_t> refined_;
+    /** \brief cells of one refined abstract edge, from its end back to its start */
+    std::vector<int64_t> segment_;
+    /** \brief state of the searches inside a cluster, on cluster-local indices */
+    SearchContext_C localCtx_;
+    /** \brief state of the search on the abstract graph, on node ids */
+    SearchContext_C absCtx_;
+    /** \brief scratch state of the cluster searches of each worker building clusters */
+    std::vector<SearchContext_C> buildCtx_;
+
+    /**
+     * @brief builds every cluster
+     * @return void
+     */
+    void build();
+
+    /**
+     * @brief builds clusters, on all hardware threads if there are many
+     * @param ids - clusters to be built
+     * @return void
+     */
+    void buildClusters(const std::vector<int64_t>& ids);
+
+    /**
+     * @brief finds the entrances of a cluster and the costs between them
+     * @param c - cluster id
+     * @param ctx - scratch state of the searches
+     * @return void
+     */
+    void buildCluster(const int64_t c, SearchContext_C& ctx);
+
+    /**
+     * @brief sets the node ids of the partners of every entrance of a cluster
+     * @param c - cluster id
+     * @return void
+     * @details both clusters split a border alike, every partner is an
+     * entrance of its cluster
+     */
+    void linkCluster(const int64_t c);
+
+    /**
+     * @brief adds the entrances of one border of a cluster
+     * @param cluster - cluster the entrances are added to
+     * @param inner - cell of the cluster at the start of the border
+     * @param outer - cell of the neighbouring cluster next to inner
+     * @param step - index step along the border
+     * @param length - number of cells along the border
+     * @return void
+     * @details runs of touching free cells are split the same way from both
+     * sides, so both clusters agree on the entrances
+     */
+    void addEntrances(cluster_S& cluster, const int64_t inner, const int64_t outer,
+                      const int64_t step, const int64_t length) const;
+
+    /**
+     * @brief cluster of a cell
+     * @param cell - linear index of the cell
+     * @return cluster id
+     */
+    int64_t clusterOf(const int64_t cell) const
+    {
+        return (cell / cols_ / clusterSize_) * numClusterCols_ + (cell % cols_) / clusterSize_;
+    }
+
+    /**
+     * @brief cell of a node of the abstract graph
+     * @param id - node id
+     * @return linear index of the cell
+     */
+    int64_t nodeCell(const int64_t id) const
+    {
+        return clusters_[id / nodeStride_].nodes[id % nodeStride_].cell;
+    }
+
+    /**
+     * @brief cells covered by a cluster
+     * @param c - cluster id
+     * @return rectangle of the cluster
+     */
+    rect_S rect(const int64_t c) const;
+
+    /**
+     * @brief cells covered by two clusters and the clusters between them
+     * @param a - cluster id
+     * @param b - cluster id
+     * @return smallest rectangle holding both clusters
+     */
+    rect_S span(const int64_t a, const int64_t b) const;
+
+    /**
+     * @brief index of a cell in the scratch state of a search inside a rectangle
+     * @param r - rectangle searched
+     * @param cell - linear index of the cell
+     * @return rectangle-local index
+     */
+    int64_t localIndex(const rect_S& r, const int64_t cell) const
+    {
+        return (cell / cols_ - r.x0) * (r.y1 - r.y0) + cell % cols_ - r.y0;
+    }
+
+    /**
+     * @brief Dijkstra/A* that never leaves a rectangle, usually a cluster
+     * @param r - rectangle searched
+     * @param src - linear index of the source cell
+     * @param reverse - follow the moves backwards, costs are then costs to src
+     * @param target - linear index of the cell to stop at, -1 to search the whole cluster
+     * @param ctx - scratch state, holds the results on rectangle-local indices
+     * @return void
+     */
+    void clusterSearch(const rect_S& r, const int64_t src, const bool reverse, const int64_t target,
+                       SearchContext_C& ctx) const;
+
+    /**
+     * @brief refines abstractPath_ into the cells of refined_
+     * @return void
+     */
+    void refinePath();
+
+    /**
+     * @brief appends to refined_ the cells after from up to to, as found by the
+     * last search of localCtx_
+     * @param r - rectangle of that search
+     * @param from - linear index of its source cell
+     * @param to - linear index of the cell it stopped at
+     * @return void
+     */
+    void appendSegment(const rect_S& r, const int64_t from, const int64_t to);
+
+    /**
+     * @brief builds the returned path from refined_
+     * @param path - receives the path from goal to start
+     * @return void
+     */
+    void buildPath(std::vector<Node_C>& path) const;
+};
+
+} // namespace planning
+
+#endif /* HPA_H_ */
@@ -0,0 +1,385 @@
+/**
+ * @file jps.cpp
+ * @author osamy
+ * @brief contains the jump point search class implementation
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "grid_motion.hpp"
+#include "jps.hpp"
+
+namespace
+{
+/**
+ * @brief octile distance, exact cost of a straight or diagonal line
+ * @param dx - row difference
+ * @param dy - column difference
+ * @return cost of the cheapest 8-connected move sequence on an empty grid
+ */
+double octile(const int64_t dx, const int64_t dy)
+{
+    return planning::Octile_S()(dx, dy);
+}
+
+/**
+ * @brief sign of a value
+ * @param v - value
+ * @return -1, 0 or 1
+ */
+int64_t sign(const int64_t v)
+{
+    return (v > 0) - (v < 0);
+}
+} // namespace
+
+bool planning::JPS_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    const bool found = planWithContext(start, goal, ctx_, path);
+#ifdef ENABLE_PLANNER_STATS
+    stats_ = ctx_.stats();
+#endif /* ENABLE_PLANNER_STATS */
+    return found;
+}
+
+bool planning::JPS_C::planWithContext(const Node_C& start, const Node_C& goal, SearchContext_C& ctx,
+                                      std::vector<Node_C>& path) const
+{
+    const OccupancyGrid_C& map = *map_;
+    ctx.reset(map.numCells());
+    path.clear();
+    PLANNER_STATS_TIMER(ctx.stats(), wallNs);
+    if (!walkable(start.x_, start.y_) || !walkable(goal.x_, goal.y_))
+    {
+        return false;
+    }
+
+    IndexedHeap_C<open_key_S>& oList = ctx.open();
+
+    const int64_t startIdx = map.index(start.x_, start.y_);
+    const int64_t goalIdx = map.index(goal.x_, goal.y_);
+    const double startH = octile(goal.x_ - start.x_, goal.y_ - start.y_);
+
+    ctx.setCost(startIdx, 0, startIdx);
+    oList.push(startIdx, {startH, startH});
+    PLANNER_STATS_ADD(ctx.stats(), pushed, 1);
+    PLANNER_STATS_MAX(ctx.stats(), maxOpenSize, 1);
+
+    /* directions to jump in, at most 8 */
+    int64_t dirs[8][2];
+
+    while (!oList.empty())
+    {
+        const int64_t curIdx = oList.top();
+        oList.pop();
+        ctx.setClosed(curIdx);
+        PLANNER_STATS_ADD(ctx.stats(), expanded, 1);
+
+        if (curIdx == goalIdx)
+        {
+            PLANNER_STATS_TIMER(ctx.stats(), reconstructionNs);
+            convertParents2Path(ctx, startIdx, goalIdx, path);
+            return true;
+        }
+
+        const int64_t x = curIdx / cols_;
+        const int64_t y = curIdx % cols_;
+        const double g = ctx.cost(curIdx);
+        PLANNER_STATS_TIMER(ctx.stats(), neighbourNs);
+        int numDirs = 0;
+        const auto addDir = [&dirs, &numDirs](const int64_t dx, const int64_t dy) {
+            dirs[numDirs][0] = dx;
+            dirs[numDirs][1] = dy;
+            numDirs++;
+        };
+
+        if (curIdx == startIdx)
+        {
+            /* no parent, every direction is a successor */
+            for (int64_t dx = -1; dx <= 1; dx++)
+            {
+                for (int64_t dy = -1; dy <= 1; dy++)
+                {
+                    if ((0 != dx || 0 != dy)
+                        && (0 == dx || 0 == dy || (walkable(x + dx, y) && walkable(x, y + dy))))
+                    {
+                        addDir(dx, dy);
+                    }
+                }
+            }
+        }
+        else
+        {
+            /* pruned neighbours, depending on the direction the cell was reached from */
+            const int64_t pIdx = ctx.parent(curIdx);
+            const int64_t dx = sign(x - pIdx / cols_);
+            const int64_t dy = sign(y - pIdx % cols_);
+
+            if (0 != dx && 0 != dy)
+            {
+                const bool nextX = walkable(x + dx, y);
+                const bool nextY = walkable(x, y + dy);
+                if (nextY)
+                {
+                    addDir(0, dy);
+                }
+                if (nextX)
+                {
+                    addDir(dx, 0);
+                }
+                if (nextX && nextY)
+                {
+                    addDir(dx, dy);
+                }
+            }
+            else if (0 != dx)
+            {
+                const bool next = walkable(x + dx, y);
+                const bool up = walkable(x, y + 1);
+                const bool down = walkable(x, y - 1);
+                if (next)
+                {
+                    addDir(dx, 0);
+                    if (up)
+                    {
+                        addDir(dx, 1);
+                    }
+                    if (down)
+                    {
+                        addDir(dx, -1);
+                    }
+                }
+                if (up)
+                {
+                    addDir(0, 1);
+                }
+                if (down)
+                {
+                    addDir(0, -1);
+                }
+            }
+            else
+            {
+                const bool next = walkable(x, y + dy);
+                const bool right = walkable(x + 1, y);
+                const bool left = walkable(x - 1, y);
+                if (next)
+                {
+                    addDir(0, dy);
+                    if (right)
+                    {
+                        addDir(1, dy);
+                    }
+                    if (left)
+                    {
+                        addDir(-1, dy);
+                    }
+                }
+                if (right)
+                {
+                    addDir(1, 0);
+                }
+                if (left)
+                {
+                    addDir(-1, 0);
+                }
+            }
+        }
+
+        for (int d = 0; d < numDirs; d++)
+        {
+            const int64_t dx = dirs[d][0];
+            const int64_t dy = dirs[d][1];
+            int64_t jx = 0;
+            int64_t jy = 0;
+            const bool found = (0 != dx && 0 != dy)
+                               ? jumpDiagonal(x + dx, y + dy, dx, dy, goal, jx, jy)
+                               : jumpStraight(x + dx, y + dy, dx, dy, goal, jx, jy);
+            if (!found)
+            {
+                continue;
+            }
+            const int64_t jIdx = map.index(jx, jy);
+            if (ctx.isClosed(jIdx))
+            {
+                continue;
+            }
+            const double newG = g + octile(jx - x, jy - y);
+            if (newG < ctx.cost(jIdx))
+            {
+                double h = 0;
+                {
+                    PLANNER_STATS_TIMER(ctx.stats(), heuristicNs);
+                    h = octile(goal.x_ - jx, goal.y_ - jy);
+                }
+                ctx.setCost(jIdx, newG, curIdx);
+                PLANNER_STATS_ADD(ctx.stats(), duplicatePushes, oList.contains(jIdx));
+                oList.push(jIdx, {newG + h, h});
+                PLANNER_STATS_ADD(ctx.stats(), pushed, 1);
+                PLANNER_STATS_MAX(ctx.stats(), maxOpenSize, oList.size());
+            }
+        }
+    }
+    return false;
+}
+
+void planning::JPS_C::setScan(const scan_E scan)
+{
+    scan_ = scan;
+    if (SCAN_WORD == scan_)
+    {
+        rowBits_ = BitGrid_C(*map_, false);
+        colBits_ = BitGrid_C(*map_, true);
+    }
+}
+
+bool planning::JPS_C::jumpStraight(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                                   const Node_C& goal, int64_t& jx, int64_t& jy) const
+{
+    if (SCAN_CELL == scan_)
+    {
+        return jumpStraightCell(x, y, dx, dy, goal, jx, jy);
+    }
+    if (0 != dy)
+    {
+        jx = x;
+        return jumpStraightWord(rowBits_, x, y, dy, goal.x_, goal.y_, jy);
+    }
+    jy = y;
+    return jumpStraightWord(colBits_, y, x, dx, goal.y_, goal.x_, jx);
+}
+
+bool planning::JPS_C::jumpStraightCell(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                                       const Node_C& goal, int64_t& jx, int64_t& jy) const
+{
+    while (walkable(x, y))
+    {
+        const bool isGoal = (x == goal.x_ && y == goal.y_);
+        /* a free cell beside the line whose predecessor is blocked forces a turn */
+        const bool forced = (0 != dx)
+            ? ((walkable(x, y - 1) && !walkable(x - dx, y - 1))
+               || (walkable(x, y + 1) && !walkable(x - dx, y + 1)))
+            : ((walkable(x - 1, y) && !walkable(x - 1, y - dy))
+               || (walkable(x + 1, y) && !walkable(x + 1, y - dy)));
+        if (isGoal || forced)
+        {
+            jx = x;
+            jy = y;
+            return true;
+        }
+        x += dx;
+        y += dy;
+    }
+    return false;
+}
+
+bool planning::JPS_C::jumpStraightWord(const BitGrid_C& bits, const int64_t r, int64_t c,
+                                       const int64_t dc, const int64_t goalR, const int64_t goalC,
+                                       int64_t& jc)
+{
+    while (true)
+    {
+        /* bit i of every word is the cell at column base + i */
+        const int64_t base = (dc > 0) ? c : c - 63;
+        const uint64_t blocked = bits.extract(r, base);
+        /* forced: free beside the line, blocked beside the previous cell on the line */
+        uint64_t stop = (~bits.extract(r - 1, base) & bits.extract(r - 1, base - dc))
+                        | (~bits.extract(r + 1, base) & bits.extract(r + 1, base - dc));
+        if (r == goalR && goalC >= base && goalC < base + 64)
+        {
+            stop |= uint64_t{1} << (goalC - base);
+        }
+
+        if (dc > 0)
+        {
+            /* only the cells before the first blocked one are reachable */
+            if (0 != blocked)
+            {
+                stop &= (blocked & (~blocked + 1)) - 1;
+            }
+            if (0 != stop)
+            {
+                jc = base + __builtin_ctzll(stop);
+                return true;
+            }
+        }
+        else
+        {
+            if (0 != blocked)
+            {
+                const int hb = 63 - __builtin_clzll(blocked);
+                stop &= ~((uint64_t{2} << hb) - 1);
+            }
+            if (0 != stop)
+            {
+                jc = base + 63 - __builtin_clzll(stop);
+                return true;
+            }
+        }
+        if (0 != blocked)
+        {
+            return false;
+        }
+        c += 64 * dc;
+    }
+}
+
+bool planning::JPS_C::jumpDiagonal(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                                   const Node_C& goal, int64_t& jx, int64_t& jy) const
+{
+    int64_t sx = 0;
+    int64_t sy = 0;
+    while (walkable(x, y))
+    {
+        /* a cell from which a straight jump finds a jump point is a jump point */
+        if ((x == goal.x_ && y == goal.y_)
+            || jumpStraight(x + dx, y, dx, 0, goal, sx, sy)
+            || jumpStraight(x, y + dy, 0, dy, goal, sx, sy))
+        {
+            jx = x;
+            jy = y;
+            return true;
+        }
+        /* no corner cutting */
+        if (!walkable(x + dx, y) || !walkable(x, y + dy))
+        {
+            return false;
+        }
+        x += dx;
+        y += dy;
+    }
+    return false;
+}
+
+void planning::JPS_C::convertParents2Path(const SearchContext_C& ctx,
+                                          const int64_t startIdx,
+                                          const int64_t goalIdx,
+                                          std::vector<Node_C>& path) const
+{
+    int64_t cur = goalIdx;
+
+    while (cur != startIdx)
+    {
+        const int64_t pIdx = ctx.parent(cur);
+        const int64_t px = pIdx / cols_;
+        const int64_t py = pIdx % cols_;
+        const double pg = ctx.cost(pIdx);
+        int64_t x = cur / cols_;
+        int64_t y = cur % cols_;
+        const int64_t dx = sign(px - x);
+        const int64_t dy = sign(py - y);
+
+        /* walk the line from the jump point back to its parent */
+        while (x != px || y != py)
+        {
+            const int64_t id = x * cols_ + y;
+            path.emplace_back(x, y, pg + octile(x - px, y - py), 0, id, (x + dx) * cols_ + (y + dy));
+            x += dx;
+            y += dy;
+        }
+        cur = pIdx;
+    }
+    path.emplace_back(startIdx / cols_, startIdx % cols_, 0, 0, startIdx, startIdx);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file jps.hpp
+ * @author osamy
+ * @brief jump point search planner class
+ */
+
+#ifndef JPS_H_
+#define JPS_H_
+
+#include "grid_engine.hpp"
+#include "search_context.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the Jump Point Search algorithm on uniform-cost 8-connected grids
+ */
+class JPS_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief how straight jumps test the cells along the line
+     */
+    enum scan_E
+    {
+        /** one cell at a time on the byte grid */
+        SCAN_CELL = 0,
+        /** 64 cells at a time on bit-packed copies of the grid */
+        SCAN_WORD
+    };
+
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @param scan - how straight jumps scan the grid
+     * @return none
+     */
+    explicit JPS_C(OccupancyGrid_C grid, const scan_E scan = SCAN_WORD)
+                : GPEngine_C(std::move(grid)) { setScan(scan); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @param scan - how straight jumps scan the grid
+     * @return none
+     */
+    explicit JPS_C(std::shared_ptr<const OccupancyGrid_C> map, const scan_E scan = SCAN_WORD)
+                : GPEngine_C(std::move(map)) { setScan(scan); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details allocation-free once the search context and the path have
+     * grown to the largest query so far
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+protected:
+    /**
+     * @brief JPS can answer queries concurrently, each with its own context
+     * @return true
+     */
+    bool supportsConcurrentQueries() const override { return true; }
+
+    /**
+     * @brief algorithm's implementation on an explicit search context
+     * @param start - start node
+     * @param goal - goal node
+     * @param ctx - search context holding all per-query state
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     */
+    bool planWithContext(const Node_C& start, const Node_C& goal, SearchContext_C& ctx,
+                         std::vector<Node_C>& path) const override;
+
+private:
+    /** \brief how straight jumps scan the grid */
+    scan_E scan_ = SCAN_WORD;
+    /** \brief bit-packed map, rows are the map's rows */
+    BitGrid_C rowBits_;
+    /** \brief bit-packed map, rows are the map's columns */
+    BitGrid_C colBits_;
+    /** \brief per-query g-cost/parent/closed state and open list */
+    SearchContext_C ctx_;
+
+    /**
+     * @brief selects the scan and builds the bit grids if needed
+     * @param scan - how straight jumps scan the grid
+     * @return void
+     */
+    void setScan(const scan_E scan);
+
+    /**
+     * @brief checks whether a cell can be entered
+     * @param x - row
+     * @param y - column
+     * @return bool whether the cell is inside the map and free
+     */
+    bool walkable(const int64_t x, const int64_t y) const
+    {
+        return x >= 0 && y >= 0 && x < rows_ && y < cols_ && 0 == (*map_)(x, y);
+    }
+
+    /**
+     * @brief jumps along a straight line
+     * @param x - row of the first cell of the jump
+     * @param y - column of the first cell of the jump
+     * @param dx - row direction, -1, 0 or 1
+     * @param dy - column direction, -1, 0 or 1, exactly one of dx/dy is 0
+     * @param goal - goal of the query, always a jump point
+     * @param jx - row of the jump point found
+     * @param jy - column of the jump point found
+     * @return bool whether a jump point was found
+     */
+    bool jumpStraight(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                      const Node_C& goal, int64_t& jx, int64_t& jy) const;
+
+    /**
+     * @brief straight jump one cell at a time
+     * @return bool whether a jump point was found
+     * @details see jumpStraight
+     */
+    bool jumpStraightCell(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                          const Node_C& goal, int64_t& jx, int64_t& jy) const;
+
+    /**
+     * @brief straight jump 64 cells at a time along a row of a bit grid
+     * @param bits - bit grid whose rows are scanned
+     * @param r - row of the bit grid
+     * @param c - column of the first cell of the jump
+     * @param dc - column direction, -1 or 1
+     * @param goalR - row of the goal in the bit grid
+     * @param goalC - column of the goal in the bit grid
+     * @param jc - column of the jump point found
+     * @return bool whether a jump point was found
+     */
+    static bool jumpStraightWord(const BitGrid_C& bits, const int64_t r, int64_t c,
+                                 const int64_t dc, const int64_t goalR, const int64_t goalC,
+                                 int64_t& jc);
+
+    /**
+     * @brief jumps along a diagonal line
+     * @param x - row of the first cell of the jump
+     * @param y - column of the first cell of the jump
+     * @param dx - row direction, -1 or 1
+     * @param dy - column direction, -1 or 1
+     * @param goal - goal of the query, always a jump point
+     * @param jx - row of the jump point found
+     * @param jy - column of the jump point found
+     * @return bool whether a jump point was found
+     */
+    bool jumpDiagonal(int64_t x, int64_t y, const int64_t dx, const int64_t dy,
+                      const Node_C& goal, int64_t& jx, int64_t& jy) const;
+
+    /**
+     * @brief builds the path by following the jump points from the goal to the
+     * start, filling in the cells between consecutive jump points
+     * @param ctx - search context of the query
+     * @param startIdx - linear index of the start cell
+     * @param goalIdx - linear index of the goal cell
+     * @param path - receives the path from goal to start
+     * @return void
+     */
+    void convertParents2Path(const SearchContext_C& ctx, const int64_t startIdx,
+                             const int64_t goalIdx, std::vector<Node_C>& path) const;
+};
+
+} // namespace planning
+
+#endif /* JPS_H_ */
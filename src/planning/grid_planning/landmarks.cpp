@@ -0,0 +1,137 @@
+/**
+ * @file landmarks.cpp
+ * @author osamy
+ * @brief contains the landmark distances implementation
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "distance_field.hpp"
+#include "landmarks.hpp"
+
+std::shared_ptr<const planning::Landmarks_C> planning::Landmarks_C::build(std::shared_ptr<const OccupancyGrid_C> map,
+                                                                          const size_t numLandmarks)
+{
+    std::shared_ptr<Landmarks_C> landmarks(new Landmarks_C());
+    landmarks->rows_ = map->rows();
+    landmarks->cols_ = map->cols();
+    landmarks->mapHash_ = hashGrid(*map);
+    const uint8_t* const cells = map->data();
+    const int64_t numCells = map->numCells();
+    landmarks->symmetric_ = std::none_of(cells, cells + numCells, [](const uint8_t v) { return v > 1; });
+
+    const int64_t cols = map->cols();
+    const auto toNode = [cols](const int64_t cell) { return Node_C(cell / cols, cell % cols); };
+    DistanceField_C field(map);
+
+    /* the first landmark is the cell farthest from a free cell near the middle */
+    int64_t next = -1;
+    for (int64_t i = 0; i < numCells && next < 0; i++)
+    {
+        if (const int64_t cell = (numCells / 2 + i) % numCells; 0 == cells[cell])
+        {
+            next = cell;
+        }
+    }
+    if (next >= 0)
+    {
+        const Node_C seed = toNode(next);
+        double farthest = 0;
+        for (int64_t cell = 0; cell < numCells; cell++)
+        {
+            if (const double d = field.distance(seed, toNode(cell)); !std::isinf(d) && d > farthest)
+            {
+                farthest = d;
+                next = cell;
+            }
+        }
+    }
+
+    /* every next landmark is the cell farthest from all landmarks so far */
+    Grid_C<uint16_t> table(numCells, static_cast<int64_t>(numLandmarks), max_distance);
+    std::vector<double> nearest(static_cast<size_t>(numCells), std::numeric_limits<double>::infinity());
+    size_t k = 0;
+    for (; k < numLandmarks && next >= 0; k++)
+    {
+        const Node_C landmark = toNode(next);
+        next = -1;
+        double farthest = 0;
+        for (int64_t cell = 0; cell < numCells; cell++)
+        {
+            const double d = field.distance(landmark, toNode(cell));
+            if (std::isinf(d))
+            {
+                continue;
+            }
+            table(cell, static_cast<int64_t>(k)) = static_cast<uint16_t>(std::min(d, static_cast<double>(max_distance)));
+            nearest[cell] = std::min(nearest[cell], d);
+            if (nearest[cell] > farthest)
+            {
+                farthest = nearest[cell];
+                next = cell;
+            }
+        }
+    }
+
+    if (k < numLandmarks)
+    {
+        /* ran out of cells away from the landmarks, keep the columns that were filled */
+        Grid_C<uint16_t> filled(numCells, static_cast<int64_t>(k));
+        for (int64_t cell = 0; cell < numCells; cell++)
+        {
+            std::copy_n(&table(cell, 0), k, &filled(cell, 0));
+        }
+        table = std::move(filled);
+    }
+    landmarks->table_ = std::make_shared<const Grid_C<uint16_t>>(std::move(table));
+    return landmarks;
+}
+
+std::shared_ptr<const planning::Landmarks_C> planning::Landmarks_C::load(const std::string& fileName, const OccupancyGrid_C& map)
+{
+    landmark_file_header_S header{};
+    auto table = loadLandmarkFile(fileName, header);
+    if (!table || header.rows != map.rows() || header.cols != map.cols() || header.mapHash != hashGrid(map))
+    {
+        return nullptr;
+    }
+    std::shared_ptr<Landmarks_C> landmarks(new Landmarks_C());
+    landmarks->table_ = std::move(table);
+    landmarks->rows_ = header.rows;
+    landmarks->cols_ = header.cols;
+    landmarks->mapHash_ = header.mapHash;
+    landmarks->symmetric_ = 0 != (header.flags & FLAG_SYMMETRIC);
+    return landmarks;
+}
+
+std::shared_ptr<const planning::Landmarks_C> planning::Landmarks_C::loadOrBuild(const std::string& fileName,
+                                                                                std::shared_ptr<const OccupancyGrid_C> map,
+                                                                                const size_t numLandmarks)
+{
+    if (auto landmarks = load(fileName, *map); landmarks && landmarks->size() == numLandmarks)
+    {
+        return landmarks;
+    }
+    auto landmarks = build(std::move(map), numLandmarks);
+    landmarks->save(fileName);
+    return landmarks;
+}
+
+bool planning::Landmarks_C::save(const std::string& fileName) const
+{
+    landmark_file_header_S header{};
+    header.flags = symmetric_ ? static_cast<uint32_t>(FLAG_SYMMETRIC) : 0U;
+    header.rows = rows_;
+    header.cols = cols_;
+    header.mapHash = mapHash_;
+    header.numLandmarks = size();
+    return writeLandmarkFile(fileName, header, *table_);
+}
+
+bool planning::Landmarks_C::matches(const OccupancyGrid_C& map) const
+{
+    return map.rows() == rows_ && map.cols() == cols_ && hashGrid(map) == mapHash_;
+}
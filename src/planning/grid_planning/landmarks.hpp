@@ -0,0 +1,130 @@
+/**
+ * @file landmarks.hpp
+ * @author osamy
+ * @brief landmark distances for the ALT lower bound of A*
+ */
+
+#ifndef LANDMARKS_H_
+#define LANDMARKS_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief distances from a few landmark cells to every cell of a map, for the ALT lower bound of A*
+ */
+class Landmarks_C
+{
+public:
+    /** \brief stored for costs from max_distance up and for cells without a path,
+     * which weakens the bounds beyond it but keeps them consistent */
+    static constexpr uint16_t max_distance = UINT16_MAX;
+
+    /**
+     * @brief picks landmarks on a map and computes their distances
+     * @param map - map of the planning task
+     * @param numLandmarks - number of landmarks, fewer if the map runs out of reachable cells
+     * @return landmarks of the map
+     */
+    static std::shared_ptr<const Landmarks_C> build(std::shared_ptr<const OccupancyGrid_C> map,
+                                                    const size_t numLandmarks);
+
+    /**
+     * @brief memory maps landmarks saved with save()
+     * @param fileName - path of the file
+     * @param map - map the landmarks are needed for
+     * @return landmarks, null if the file cannot be loaded or belongs to another map
+     */
+    static std::shared_ptr<const Landmarks_C> load(const std::string& fileName, const OccupancyGrid_C& map);
+
+    /**
+     * @brief loads the landmarks of a map, or builds and saves them if there are none yet
+     * @param fileName - path of the file
+     * @param map - map of the planning task
+     * @param numLandmarks - number of landmarks to build
+     * @return landmarks of the map
+     * @details the file is overwritten if it belongs to another map; failing
+     * to write it is not an error, the landmarks are built again next time
+     */
+    static std::shared_ptr<const Landmarks_C> loadOrBuild(const std::string& fileName,
+                                                          std::shared_ptr<const OccupancyGrid_C> map,
+                                                          const size_t numLandmarks);
+
+    /**
+     * @brief saves the landmarks
+     * @param fileName - path of the file, overwritten if it exists
+     * @return validity flag
+     */
+    bool save(const std::string& fileName) const;
+
+    /**
+     * @brief checks whether the landmarks were computed on a map
+     * @param map - map to be checked
+     * @return bool whether the map has the size and cells the landmarks were computed on
+     */
+    bool matches(const OccupancyGrid_C& map) const;
+
+    /**
+     * @brief number of landmarks
+     * @return number of landmarks
+     */
+    size_t size() const { return static_cast<size_t>(table_->cols()); }
+
+    /**
+     * @brief lower bound of the cost between two cells
+     * @param cell - index x * cols + y of the cell the cost is from
+     * @param goal - index of the cell the cost is to
+     * @return largest landmark bound, 0 without landmarks
+     */
+    double lowerBound(const int64_t cell, const int64_t goal) const
+    {
+        const int64_t k = table_->cols();
+        const uint16_t* const c = table_->data() + cell * k;
+        const uint16_t* const g = table_->data() + goal * k;
+        int32_t best = 0;
+        for (int64_t l = 0; l < k; l++)
+        {
+            const int32_t d = static_cast<int32_t>(g[l]) - static_cast<int32_t>(c[l]);
+            best = std::max(best, symmetric_ ? std::abs(d) : d);
+        }
+        return static_cast<double>(best);
+    }
+
+private:
+    /** \brief properties stored in the flags of a landmark file */
+    enum flags_E : uint32_t
+    {
+        /** \brief every cell is free or an obstacle, the costs are symmetric */
+        FLAG_SYMMETRIC = 1U
+    };
+
+    /** \brief distances from each landmark, a row per cell and a column per landmark */
+    std::shared_ptr<const Grid_C<uint16_t>> table_;
+    /** \brief number of rows of the map */
+    int64_t rows_ = 0;
+    /** \brief number of columns of the map */
+    int64_t cols_ = 0;
+    /** \brief hashGrid() of the map */
+    uint64_t mapHash_ = 0;
+    /** \brief whether the costs between two cells are the same both ways */
+    bool symmetric_ = false;
+
+    /**
+     * @brief constructor, landmarks are made by build() and load()
+     * @return none
+     */
+    Landmarks_C() = default;
+};
+
+} // namespace planning
+
+#endif /* LANDMARKS_H_ */
@@ -0,0 +1,212 @@
+/**
+ * @file lpastar.cpp
+ * @author osamy
+ * @brief contains the LPA* class implementation
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "lpastar.hpp"
+
+namespace
+{
+constexpr double inf = std::numeric_limits<double>::infinity();
+} // namespace
+
+bool planning::LPAStar_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    stats_ = SearchStats_S();
+    PLANNER_STATS_TIMER(stats_, wallNs);
+    path.clear();
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+
+    const int64_t startIdx = padded_.index(start.x_ + 1, start.y_ + 1);
+    const int64_t goalIdx = padded_.index(goal.x_ + 1, goal.y_ + 1);
+    if (goalIdx != goalIdx_)
+    {
+        startIdx_ = startIdx;
+        initialize(goalIdx);
+    }
+    else if (startIdx != startIdx_)
+    {
+        /* g and rhs stay valid, only the heuristic part of the keys changes */
+        const int64_t lastStartIdx = startIdx_;
+        startIdx_ = startIdx;
+        open_.rekey([this](const int64_t idx) { return calculateKey(idx); });
+        /* an obstacle only has an rhs while it is the start, see updateVertex */
+        updateVertex(lastStartIdx);
+        updateVertex(startIdx);
+    }
+    computeShortestPath();
+
+    if (std::isinf(g_[startIdx]))
+    {
+        return false;
+    }
+
+    /* follow the cheapest successors from the start, each step lowers g by the step's cost */
+    PLANNER_STATS_TIMER(stats_, reconstructionNs);
+    const uint8_t* const cells = padded_.data();
+    cells_.assign(1, startIdx);
+    while (cells_.back() != goalIdx)
+    {
+        if (static_cast<int64_t>(cells_.size()) > padded_.numCells())
+        {
+            /* cannot happen with consistent costs, guards against looping forever */
+            return false;
+        }
+        const int64_t cur = cells_.back();
+        int64_t next = -1;
+        double best = inf;
+        for (const int64_t offset : offsets_)
+        {
+            const int64_t s = cur + offset;
+            const double c = cellCost(cells[s]) + g_[s];
+            if (c < best)
+            {
+                best = c;
+                next = s;
+            }
+        }
+        cells_.push_back(next);
+    }
+
+    const int64_t stride = padded_.cols();
+    /* id of a cell in the map from its index in padded_ */
+    const auto toId = [this, stride](const int64_t idx) { return (idx / stride - 1) * cols_ + idx % stride - 1; };
+    /* the cost of a cell is its cost from the start */
+    const double total = g_[startIdx];
+    for (size_t i = cells_.size() - 1; i > 0; i--)
+    {
+        const int64_t cur = cells_[i];
+        path.emplace_back(cur / stride - 1, cur % stride - 1, total - g_[cur], 0, toId(cur), toId(cells_[i - 1]));
+    }
+    path.emplace_back(start.x_, start.y_, 0, 0, toId(startIdx), toId(startIdx));
+    return true;
+}
+
+void planning::LPAStar_C::updateCells(const std::vector<Node_C>& cells, const uint8_t value)
+{
+    for (const auto& c : cells)
+    {
+        if (checkOutsideBoundary(c, rows_, cols_))
+        {
+            continue;
+        }
+        const int64_t idx = padded_.index(c.x_ + 1, c.y_ + 1);
+        if (padded_[idx] == value)
+        {
+            continue;
+        }
+        padded_[idx] = value;
+        if (goalIdx_ < 0)
+        {
+            continue;
+        }
+        /* the cost of entering the cell changed, which is part of the rhs of
+         * its neighbours; the cell's own rhs changes if it became an obstacle */
+        updateVertex(idx);
+        for (const int64_t offset : offsets_)
+        {
+            updateVertex(idx + offset);
+        }
+    }
+}
+
+void planning::LPAStar_C::pad()
+{
+    padded_ = padGrid(*map_, 1, static_cast<uint8_t>(1));
+    for (int m = 0; m < FourConnected_S::connectivity; m++)
+    {
+        offsets_[m] = FourConnected_S::dx[m] * padded_.cols() + FourConnected_S::dy[m];
+    }
+    /* the path is cut once it is longer than the map, it never grows past that */
+    cells_.reserve(static_cast<size_t>(padded_.numCells()) + 1);
+}
+
+void planning::LPAStar_C::initialize(const int64_t goalIdx)
+{
+    const auto numCells = static_cast<size_t>(padded_.numCells());
+    g_.assign(numCells, inf);
+    rhs_.assign(numCells, inf);
+    open_.clear();
+    open_.resize(padded_.numCells());
+    goalIdx_ = goalIdx;
+    rhs_[goalIdx_] = 0;
+    open_.push(goalIdx_, calculateKey(goalIdx_));
+    PLANNER_STATS_ADD(stats_, pushed, 1);
+    PLANNER_STATS_MAX(stats_, maxOpenSize, open_.size());
+}
+
+key_S planning::LPAStar_C::calculateKey(const int64_t idx)
+{
+    /* cells with equal f are taken nearer the goal first, which the repairs
+     * rely on, so the first query to a goal expands about every cell on a
+     * shortest path rather than the single line A* follows on an open map */
+    PLANNER_STATS_TIMER(stats_, heuristicNs);
+    const int64_t stride = padded_.cols();
+    const double m = std::min(g_[idx], rhs_[idx]);
+    return {m + Manhattan_S()(idx / stride - startIdx_ / stride, idx % stride - startIdx_ % stride), m};
+}
+
+void planning::LPAStar_C::updateVertex(const int64_t idx)
+{
+    if (idx != goalIdx_)
+    {
+        /* obstacles, the border included, are never left, apart from the start */
+        double best = inf;
+        if (isTraversable(padded_[idx]) || idx == startIdx_)
+        {
+            for (const int64_t offset : offsets_)
+            {
+                const int64_t s = idx + offset;
+                best = std::min(best, cellCost(padded_[s]) + g_[s]);
+            }
+        }
+        rhs_[idx] = best;
+    }
+
+    if (g_[idx] != rhs_[idx])
+    {
+        PLANNER_STATS_ADD(stats_, duplicatePushes, open_.contains(idx));
+        open_.push(idx, calculateKey(idx));
+        PLANNER_STATS_ADD(stats_, pushed, 1);
+        PLANNER_STATS_MAX(stats_, maxOpenSize, open_.size());
+    }
+    else
+    {
+        open_.remove(idx);
+    }
+}
+
+void planning::LPAStar_C::computeShortestPath()
+{
+    while (!open_.empty() && (open_.topKey() < calculateKey(startIdx_) || rhs_[startIdx_] != g_[startIdx_]))
+    {
+        const int64_t u = open_.top();
+        open_.pop();
+        PLANNER_STATS_ADD(stats_, expanded, 1);
+        PLANNER_STATS_TIMER(stats_, neighbourNs);
+
+        if (g_[u] > rhs_[u])
+        {
+            g_[u] = rhs_[u];
+        }
+        else
+        {
+            g_[u] = inf;
+            updateVertex(u);
+        }
+        /* the cells that can move into u, the motions are symmetric */
+        for (const int64_t offset : offsets_)
+        {
+            updateVertex(u + offset);
+        }
+    }
+}
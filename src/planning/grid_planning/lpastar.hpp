@@ -0,0 +1,116 @@
+/**
+ * @file lpastar.hpp
+ * @author osamy
+ * @brief Lifelong Planning A* (LPA*) planner class
+ */
+
+#ifndef LPASTAR_H_
+#define LPASTAR_H_
+
+#include <array>
+#include <vector>
+
+#include "grid_engine.hpp"
+#include "grid_motion.hpp"
+#include "indexed_heap.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for using the LPA* algorithm, for repeated queries to the same goal
+ */
+class LPAStar_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @return none
+     */
+    explicit LPAStar_C(OccupancyGrid_C grid)
+                : GPEngine_C(std::move(grid)) { pad(); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @return none
+     */
+    explicit LPAStar_C(std::shared_ptr<const OccupancyGrid_C> map)
+                : GPEngine_C(std::move(map)) { pad(); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details a call with the same goal as the previous one reuses its search
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief changes cells of the planner's copy of the map
+     * @param cells - cells to be changed, only their coordinates are used
+     * @param value - new value of the cells
+     * @return void
+     * @details the costs that depend on the cells are repaired by the next query
+     */
+    void updateCells(const std::vector<Node_C>& cells, const uint8_t value) override;
+
+private:
+    /** \brief the map with a border of obstacles around it, including the changes */
+    OccupancyGrid_C padded_;
+    /** \brief index offset of the neighbour reached by each motion in padded_ */
+    std::array<int64_t, FourConnected_S::connectivity> offsets_{};
+    /** \brief cost from each cell of padded_ to the goal */
+    std::vector<double> g_;
+    /** \brief one step lookahead cost from each cell of padded_ to the goal */
+    std::vector<double> rhs_;
+    /** \brief cells whose g and rhs differ */
+    IndexedHeap_C<key_S> open_;
+    /** \brief index in padded_ of the goal the search state belongs to, -1 if none */
+    int64_t goalIdx_ = -1;
+    /** \brief index in padded_ of the start the keys are computed for */
+    int64_t startIdx_ = -1;
+    /** \brief cells from the start to the goal, reused between queries */
+    std::vector<int64_t> cells_;
+
+    /**
+     * @brief builds padded_ and offsets_ from the map
+     * @return void
+     */
+    void pad();
+
+    /**
+     * @brief resets the search state for a new goal
+     * @param goalIdx - index of the goal in padded_
+     * @return void
+     */
+    void initialize(const int64_t goalIdx);
+
+    /**
+     * @brief key of a cell
+     * @param idx - index of the cell in padded_
+     * @return priority of the cell in open_
+     */
+    key_S calculateKey(const int64_t idx);
+
+    /**
+     * @brief recomputes the rhs value of a cell and its membership in open_
+     * @param idx - index of the cell in padded_
+     * @return void
+     */
+    void updateVertex(const int64_t idx);
+
+    /**
+     * @brief expands inconsistent cells until the start is consistent
+     * @return void
+     */
+    void computeShortestPath();
+};
+
+} // namespace planning
+
+#endif /* LPASTAR_H_ */
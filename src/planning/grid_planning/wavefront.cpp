@@ -0,0 +1,216 @@
+/**
+ * @file wavefront.cpp
+ * @author osamy
+ * @brief contains the wavefront distance field class implementation
+ */
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "grid_motion.hpp"
+#include "wavefront.hpp"
+
+namespace
+{
+/* bit (x & 7) * 8 + (y & 7) of a block is the cell of row x and column y, so
+ * the rows of a block are its bytes and a column is a bit of every byte */
+constexpr uint64_t first_row = 0x00000000000000FFull;
+constexpr uint64_t last_row = 0xFF00000000000000ull;
+constexpr uint64_t first_col = 0x0101010101010101ull;
+constexpr uint64_t last_col = 0x8080808080808080ull;
+} // namespace
+
+bool planning::WavefrontField_C::planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path)
+{
+    stats_ = SearchStats_S();
+    PLANNER_STATS_TIMER(stats_, wallNs);
+    path.clear();
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return false;
+    }
+    sweep(goal);
+    const uint32_t total = cellDistance(start.x_, start.y_);
+    if (no_distance == total)
+    {
+        return false;
+    }
+
+    /* every step lowers the distance by 1, any neighbour that does is on a shortest path */
+    PLANNER_STATS_TIMER(stats_, reconstructionNs);
+    cells_.assign(1, {start.x_, start.y_});
+    for (uint32_t d = total; d > 0; d--)
+    {
+        const auto [x, y] = cells_.back();
+        for (int m = 0; m < FourConnected_S::connectivity; m++)
+        {
+            /* cells around the map are in the blocks around it, never reached */
+            const int64_t nx = x + FourConnected_S::dx[m];
+            const int64_t ny = y + FourConnected_S::dy[m];
+            if (dist_[cellIndex(nx, ny)] == d - 1)
+            {
+                cells_.emplace_back(nx, ny);
+                break;
+            }
+        }
+    }
+
+    const auto toId = [this](const std::pair<int64_t, int64_t>& c) { return c.first * cols_ + c.second; };
+    for (size_t i = cells_.size() - 1; i > 0; i--)
+    {
+        const auto [x, y] = cells_[i];
+        path.emplace_back(x, y, total - dist_[cellIndex(x, y)], 0, toId(cells_[i]), toId(cells_[i - 1]));
+    }
+    path.emplace_back(start.x_, start.y_, 0, 0, toId(cells_[0]), toId(cells_[0]));
+    return true;
+}
+
+double planning::WavefrontField_C::distance(const Node_C& start, const Node_C& goal)
+{
+    if (checkOutsideBoundary(start, rows_, cols_) || checkOutsideBoundary(goal, rows_, cols_))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    sweep(goal);
+    const uint32_t d = cellDistance(start.x_, start.y_);
+    return (no_distance == d) ? std::numeric_limits<double>::infinity() : static_cast<double>(d);
+}
+
+void planning::WavefrontField_C::updateCells(const std::vector<Node_C>& cells, const uint8_t value)
+{
+    for (const auto& c : cells)
+    {
+        if (checkOutsideBoundary(c, rows_, cols_))
+        {
+            continue;
+        }
+        const int64_t idx = cellIndex(c.x_, c.y_);
+        const uint64_t bit = uint64_t{1} << (idx & 63);
+        const uint64_t cell = isTraversable(value) ? bit : 0;
+        if ((free_[idx >> 6] & bit) != cell)
+        {
+            free_[idx >> 6] ^= bit;
+            /* the field is swept again by the next query */
+            goalX_ = -1;
+        }
+    }
+}
+
+void planning::WavefrontField_C::pack()
+{
+    blockCols_ = (cols_ + 7) / 8 + 2;
+    const auto numBlocks = static_cast<size_t>(((rows_ + 7) / 8 + 2) * blockCols_);
+    free_.assign(numBlocks, 0);
+    wave_.assign(numBlocks, 0);
+    next_.assign(numBlocks, 0);
+    reached_.assign(numBlocks, 0);
+    dist_.assign(numBlocks * 64, no_distance);
+    /* a block is in a wave and a cell on the path at most once, so queries never grow these */
+    waveBlocks_.reserve(numBlocks);
+    nextBlocks_.reserve(numBlocks);
+    cells_.reserve(static_cast<size_t>(rows_ * cols_));
+    for (int64_t x = 0; x < rows_; x++)
+    {
+        for (int64_t y = 0; y < cols_; y++)
+        {
+            if (isTraversable((*map_)(x, y)))
+            {
+                const int64_t idx = cellIndex(x, y);
+                free_[idx >> 6] |= uint64_t{1} << (idx & 63);
+            }
+        }
+    }
+}
+
+uint32_t planning::WavefrontField_C::cellDistance(const int64_t x, const int64_t y) const
+{
+    if (x == goalX_ && y == goalY_)
+    {
+        return 0;
+    }
+    const int64_t idx = cellIndex(x, y);
+    if (0 != ((free_[idx >> 6] >> (idx & 63)) & 1U))
+    {
+        return dist_[idx];
+    }
+    /* an obstacle is never entered, but it can be left as a start */
+    uint32_t best = no_distance;
+    for (int m = 0; m < FourConnected_S::connectivity; m++)
+    {
+        best = std::min(best, dist_[cellIndex(x + FourConnected_S::dx[m], y + FourConnected_S::dy[m])]);
+    }
+    return (no_distance == best) ? no_distance : best + 1;
+}
+
+void planning::WavefrontField_C::sweep(const Node_C& goal)
+{
+    if (goal.x_ == goalX_ && goal.y_ == goalY_)
+    {
+        return;
+    }
+    goalX_ = goal.x_;
+    goalY_ = goal.y_;
+    std::fill(dist_.begin(), dist_.end(), no_distance);
+    std::fill(reached_.begin(), reached_.end(), 0);
+
+    const int64_t goalIdx = cellIndex(goalX_, goalY_);
+    waveBlocks_.clear();
+    /* nothing reaches a goal that is an obstacle, it can never be entered */
+    if (0 != ((free_[goalIdx >> 6] >> (goalIdx & 63)) & 1U))
+    {
+        dist_[goalIdx] = 0;
+        const uint64_t bit = uint64_t{1} << (goalIdx & 63);
+        wave_[goalIdx >> 6] = bit;
+        reached_[goalIdx >> 6] = bit;
+        waveBlocks_.push_back(goalIdx >> 6);
+    }
+
+    PLANNER_STATS_TIMER(stats_, neighbourNs);
+    for (uint32_t level = 1; !waveBlocks_.empty(); level++)
+    {
+        /* shift every cell of the wave onto its 4 neighbours, the cells that
+         * leave their block through a side enter the block on that side */
+        for (const int64_t b : waveBlocks_)
+        {
+            const uint64_t w = wave_[b];
+            wave_[b] = 0;
+            grow(b, (w >> 8) | (w << 8) | ((w << 1) & ~first_col) | ((w >> 1) & ~last_col));
+            if (0 != (w & first_row))
+            {
+                grow(b - blockCols_, (w & first_row) << 56);
+            }
+            if (0 != (w & last_row))
+            {
+                grow(b + blockCols_, (w & last_row) >> 56);
+            }
+            if (0 != (w & first_col))
+            {
+                grow(b - 1, (w & first_col) << 7);
+            }
+            if (0 != (w & last_col))
+            {
+                grow(b + 1, (w & last_col) >> 7);
+            }
+        }
+
+        /* the grown cells are the next wave, at one more move from the goal */
+        for (const int64_t b : nextBlocks_)
+        {
+            uint64_t cells = next_[b];
+            next_[b] = 0;
+            reached_[b] |= cells;
+            wave_[b] = cells;
+            PLANNER_STATS_ADD(stats_, expanded, __builtin_popcountll(cells));
+            uint32_t* const dist = &dist_[b * 64];
+            while (0 != cells)
+            {
+                dist[__builtin_ctzll(cells)] = level;
+                cells &= cells - 1;
+            }
+        }
+        PLANNER_STATS_MAX(stats_, maxOpenSize, nextBlocks_.size());
+        waveBlocks_.swap(nextBlocks_);
+        nextBlocks_.clear();
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file wavefront.hpp
+ * @author osamy
+ * @brief bit-parallel wavefront distance field class
+ */
+
+#ifndef WAVEFRONT_H_
+#define WAVEFRONT_H_
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "grid_engine.hpp"
+#include "utils.hpp"
+
+namespace planning
+{
+
+/**
+ * @brief class for exact distances to a goal on maps where every move costs 1
+ */
+class WavefrontField_C : public GPEngine_C
+{
+public:
+    /**
+     * @brief constructor
+     * @param grid - grid map for the planning task
+     * @return none
+     */
+    explicit WavefrontField_C(OccupancyGrid_C grid)
+                : GPEngine_C(std::move(grid)) { pack(); }
+
+    /**
+     * @brief constructor
+     * @param map - shared map for the planning task
+     * @return none
+     */
+    explicit WavefrontField_C(std::shared_ptr<const OccupancyGrid_C> map)
+                : GPEngine_C(std::move(map)) { pack(); }
+
+    /**
+     * @brief algorithm's implementation into a path owned by the caller
+     * @param start - start node
+     * @param goal - goal node
+     * @param path - receives the path from goal to start, empty if there is none
+     * @return bool whether there is a path
+     * @details sweeps the map from the goal unless its field is kept
+     */
+    bool planInto(const Node_C& start, const Node_C& goal, std::vector<Node_C>& path) override;
+
+    /**
+     * @brief number of moves of the shortest path between two cells
+     * @param start - start node
+     * @param goal - goal node
+     * @return cost, infinity if there is no path or a node is outside the map
+     * @details sweeps the map from the goal unless its field is kept, so
+     * queries to the same goal only read the field
+     */
+    double distance(const Node_C& start, const Node_C& goal);
+
+    /**
+     * @brief changes cells of the planner's copy of the map
+     * @param cells - cells to be changed, only their coordinates are used
+     * @param value - new value of the cells
+     * @return void
+     * @details the field is swept again by the next query if any cell changed
+     */
+    void updateCells(const std::vector<Node_C>& cells, const uint8_t value) override;
+
+private:
+    /** \brief number of blocks per row of blocks, including a block on each side */
+    int64_t blockCols_ = 0;
+    /** \brief free cells of each block, the blocks around the map have none */
+    std::vector<uint64_t> free_;
+    /** \brief cells of each block the current wave reached */
+    std::vector<uint64_t> wave_;
+    /** \brief cells of each block the next wave reaches */
+    std::vector<uint64_t> next_;
+    /** \brief cells of each block reached by any wave */
+    std::vector<uint64_t> reached_;
+    /** \brief blocks with cells in wave_ */
+    std::vector<int64_t> waveBlocks_;
+    /** \brief blocks with cells in next_ */
+    std::vector<int64_t> nextBlocks_;
+    /** \brief distance of each cell to the goal, 64 per block, no_distance if not reached */
+    std::vector<uint32_t> dist_;
+    /** \brief row of the goal of the field, -1 if there is no field */
+    int64_t goalX_ = -1;
+    /** \brief column of the goal of the field */
+    int64_t goalY_ = -1;
+    /** \brief cells from the start to the goal, reused between queries */
+    std::vector<std::pair<int64_t, int64_t>> cells_;
+
+    /** \brief distance of the cells that cannot reach the goal */
+    static constexpr uint32_t no_distance = UINT32_MAX;
+
+    /**
+     * @brief builds the blocks of free cells from the map
+     * @return void
+     */
+    void pack();
+
+    /**
+     * @brief index of a cell in dist_
+     * @param x - row of the cell
+     * @param y - column of the cell
+     * @return index, the block of the cell times 64 plus the cell's bit
+     */
+    int64_t cellIndex(const int64_t x, const int64_t y) const
+    {
+        return (((x >> 3) + 1) * blockCols_ + (y >> 3) + 1) * 64 + (((x & 7) << 3) | (y & 7));
+    }
+
+    /**
+     * @brief distance of a cell to the goal of the field
+     * @param x - row of the cell
+     * @param y - column of the cell
+     * @return distance, no_distance if the cell cannot reach the goal
+     * @details an obstacle has the distance of the cell it would move to
+     */
+    uint32_t cellDistance(const int64_t x, const int64_t y) const;
+
+    /**
+     * @brief sweeps the field of a goal unless it is the current one
+     * @param goal - goal node, inside the map
+     * @return void
+     */
+    void sweep(const Node_C& goal);
+
+    /**
+     * @brief adds cells to a block of the next wave
+     * @param block - index of the block
+     * @param cells - bits of the cells, only the free and not yet reached ones are added
+     * @return void
+     */
+    void grow(const int64_t block, uint64_t cells)
+    {
+        cells &= free_[block] & ~reached_[block];
+        if (0 != cells)
+        {
+            if (0 == next_[block])
+            {
+                nextBlocks_.push_back(block);
+            }
+            next_[block] |= cells;
+        }
+    }
+};
+
+} // namespace planning
+
+#endif /* WAVEFRONT_H_ */
@@ -0,0 +1,62 @@
+/**
+ * @file trace_decode.cpp
+ * @author osamy
+ * @brief converts a binary trace file to the logger's txt or csv layout
+ * @details usage: trace_decode <trace file> <output file>, the extension of
+ * the output file (.txt or .csv) selects the layout. the records are written
+ * with the options the trace was recorded with.
+ */
+
+/* C/C++ standard includes */
+#include <filesystem>
+#include <string>
+#include <thread>
+
+/* project-specific includes */
+#include "utils.hpp"
+
+int main(int argc, char** argv)
+{
+    if (3 != argc)
+    {
+        std::cerr << "usage: " << argv[0] << " <trace file> <output file .txt|.csv>\n";
+        return 1;
+    }
+
+    TraceReader_C reader;
+    if (!reader.open(argv[1]))
+    {
+        std::cerr << "cannot read trace file " << argv[1] << '\n';
+        return 1;
+    }
+
+    const std::filesystem::path out = std::filesystem::absolute(argv[2]);
+    if (".txt" != out.extension() && ".csv" != out.extension())
+    {
+        std::cerr << "output file must end in .txt or .csv\n";
+        return 1;
+    }
+    Logger_C logger(out.extension().string(), out.stem().string(), out.parent_path().string() + "/");
+    logger.setLogBitMap(reader.logBitMap());
+    if (!logger.start())
+    {
+        std::cerr << "cannot write output file " << out.string() << '\n';
+        return 1;
+    }
+
+    uint64_t numRecords = 0;
+    data_logger_S data;
+    while (reader.next(data))
+    {
+        /* the decoder has nothing else to do, wait for the writer thread */
+        while (!logger.log(std::move(data)))
+        {
+            std::this_thread::yield();
+        }
+        numRecords++;
+    }
+
+    const bool valid = logger.stop();
+    std::cout << numRecords << " records written to " << out.string() << '\n';
+    return valid ? 0 : 1;
+}
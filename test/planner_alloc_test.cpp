@@ -0,0 +1,216 @@
+/**
+ * @file planner_alloc_test.cpp
+ * @author osamy
+ * @brief checks that the planners answer queries through planInto() without allocating
+ * @details every planner is warmed up with a few queries on a map, then asked
+ * queries it has not seen, longer ones across the whole map included. the
+ * test fails if any of those queries makes a heap allocation. the caller's
+ * path is reserved for every cell of the map once, as a caller keeping its
+ * cycle allocation-free would.
+ * DStarLite_C is left out: its search state lives in node sets that allocate
+ * on every change.
+ */
+
+/* C/C++ standard includes */
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+/* project-specific includes */
+#include "arastar.hpp"
+#include "astar.hpp"
+#include "biastar.hpp"
+#include "distance_field.hpp"
+#include "hpa.hpp"
+#include "jps.hpp"
+#include "landmarks.hpp"
+#include "lpastar.hpp"
+#include "utils.hpp"
+#include "wavefront.hpp"
+
+/** \brief number of heap allocations made by the process so far */
+static std::atomic<uint64_t> numAllocations{0};
+
+/**
+ * @brief counts every heap allocation of the test
+ * @param size - number of bytes
+ * @return allocated memory
+ */
+void* operator new(const size_t size)
+{
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(0 == size ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * @brief releases memory from the counting operator new
+ * @param p - memory to release
+ * @return void
+ */
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief releases memory from the counting operator new
+ * @param p - memory to release
+ * @return void
+ */
+void operator delete(void* p, const size_t) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * @brief a planner under test
+ */
+struct planner_S
+{
+    /** \brief name shown in the report */
+    std::string name;
+    /** \brief creates the planner on a map */
+    std::function<std::unique_ptr<planning::GPEngine_C>(std::shared_ptr<const OccupancyGrid_C>)> make;
+};
+
+/**
+ * @brief draws a free cell of a map
+ * @param grid - map
+ * @param eng - generator
+ * @return free cell
+ */
+static Node_C freeCell(const OccupancyGrid_C& grid, std::mt19937& eng)
+{
+    std::uniform_int_distribution<int64_t> cell(0, grid.numCells() - 1);
+    while (true)
+    {
+        if (const int64_t i = cell(eng); 0 == grid[i])
+        {
+            return Node_C(i / grid.cols(), i % grid.cols(), 0, 0, i, i);
+        }
+    }
+}
+
+/**
+ * @brief the free cell nearest to a corner of a map, along its diagonal
+ * @param grid - map
+ * @param x - row of the corner
+ * @param y - column of the corner
+ * @return free cell
+ */
+static Node_C freeCorner(const OccupancyGrid_C& grid, const int64_t x, const int64_t y)
+{
+    const int64_t dx = (0 == x) ? 1 : -1;
+    const int64_t dy = (0 == y) ? 1 : -1;
+    for (int64_t d = 0; d < grid.rows(); d++)
+    {
+        for (int64_t k = 0; k <= d; k++)
+        {
+            const int64_t cx = x + dx * k;
+            const int64_t cy = y + dy * (d - k);
+            if (cx >= 0 && cx < grid.rows() && cy >= 0 && cy < grid.cols() && 0 == grid(cx, cy))
+            {
+                return Node_C(cx, cy, 0, 0, cx * grid.cols() + cy, cx * grid.cols() + cy);
+            }
+        }
+    }
+    return Node_C(x, y);
+}
+
+int main()
+{
+    using map_T = std::shared_ptr<const OccupancyGrid_C>;
+    const std::vector<planner_S> planners = {
+        {"AStar_C", [](map_T m) { return std::make_unique<planning::AStar_C>(m); }},
+        {"AStar_C ALT",
+         [](map_T m) {
+             auto aStar = std::make_unique<planning::AStar_C>(m);
+             aStar->setLandmarks(planning::Landmarks_C::build(m, 4));
+             return aStar;
+         }},
+        {"AStar8_C", [](map_T m) { return std::make_unique<planning::AStar8_C>(m); }},
+        {"Dijkstra_C", [](map_T m) { return std::make_unique<planning::Dijkstra_C>(m); }},
+        {"ARAStar_C", [](map_T m) { return std::make_unique<planning::ARAStar_C>(m); }},
+        {"ARAStar8_C", [](map_T m) { return std::make_unique<planning::ARAStar8_C>(m); }},
+        {"BiAStar_C", [](map_T m) { return std::make_unique<planning::BiAStar_C>(m); }},
+        {"BiAStar8_C", [](map_T m) { return std::make_unique<planning::BiAStar8_C>(m); }},
+        {"BiDijkstra_C", [](map_T m) { return std::make_unique<planning::BiDijkstra_C>(m); }},
+        {"DistanceField_C", [](map_T m) { return std::make_unique<planning::DistanceField_C>(m); }},
+        {"HPA_C", [](map_T m) { return std::make_unique<planning::HPA_C>(m); }},
+        {"JPS_C cell", [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_CELL); }},
+        {"JPS_C word", [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_WORD); }},
+        {"LPAStar_C", [](map_T m) { return std::make_unique<planning::LPAStar_C>(m); }},
+        {"WavefrontField_C", [](map_T m) { return std::make_unique<planning::WavefrontField_C>(m); }},
+    };
+
+    constexpr int64_t side = 96;
+    constexpr uint32_t seed = 7;
+    constexpr size_t numWarmUp = 3;
+    constexpr size_t numFresh = 40;
+
+    std::vector<std::pair<std::string, map_T>> maps;
+    for (const double density : {0.0, 0.2})
+    {
+        auto grid = std::make_shared<OccupancyGrid_C>(side, side, 0);
+        makeGrid(*grid, seed, density);
+        maps.emplace_back("random " + std::to_string(density).substr(0, 3), grid);
+    }
+    {
+        auto grid = std::make_shared<OccupancyGrid_C>(side, side, 0);
+        makeMazeGrid(*grid, seed);
+        maps.emplace_back("maze", grid);
+    }
+
+    int failures = 0;
+    for (const auto& [mapName, map] : maps)
+    {
+        /* short queries to warm up, then queries never seen, from corner to corner too */
+        std::mt19937 eng(seed);
+        std::vector<std::pair<Node_C, Node_C>> warmUp;
+        for (size_t q = 0; q < numWarmUp; q++)
+        {
+            const Node_C start = freeCell(*map, eng);
+            warmUp.emplace_back(start, start);
+        }
+        std::vector<std::pair<Node_C, Node_C>> fresh;
+        for (size_t q = 0; q < numFresh; q++)
+        {
+            fresh.emplace_back(freeCell(*map, eng), freeCell(*map, eng));
+        }
+        fresh.emplace_back(freeCorner(*map, 0, 0), freeCorner(*map, side - 1, side - 1));
+        fresh.emplace_back(freeCorner(*map, side - 1, 0), freeCorner(*map, 0, side - 1));
+
+        for (const auto& planner : planners)
+        {
+            auto p = planner.make(map);
+            std::vector<Node_C> path;
+            path.reserve(static_cast<size_t>(map->numCells()));
+            for (const auto& [start, goal] : warmUp)
+            {
+                p->planInto(start, goal, path);
+            }
+            const uint64_t before = numAllocations.load();
+            size_t found = 0;
+            for (const auto& [start, goal] : fresh)
+            {
+                found += p->planInto(start, goal, path) ? 1 : 0;
+            }
+            const uint64_t allocs = numAllocations.load() - before;
+            const bool ok = (0 == allocs) && (found > 0);
+            failures += ok ? 0 : 1;
+            std::cout << (ok ? "ok      " : "FAILED  ") << mapName << "  " << planner.name << ": " << allocs
+                      << " allocations, " << found << "/" << fresh.size() << " paths" << '\n';
+        }
+    }
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
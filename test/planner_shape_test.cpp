@@ -0,0 +1,178 @@
+/**
+ * @file planner_shape_test.cpp
+ * @author osamy
+ * @brief checks every planner on maps that are not square
+ * @details every planner answers random queries on maps with more columns
+ * than rows and the other way round. the test fails if a planner finds a
+ * path where the reference does not or the other way round, if a path does
+ * not join the start to the goal through free neighbouring cells, if a node
+ * id is not row * cols + column, or if the cost of an optimal planner differs
+ * from the reference.
+ */
+
+/* C/C++ standard includes */
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/* project-specific includes */
+#include "arastar.hpp"
+#include "astar.hpp"
+#include "biastar.hpp"
+#include "distance_field.hpp"
+#include "dstarlite.hpp"
+#include "hpa.hpp"
+#include "jps.hpp"
+#include "landmarks.hpp"
+#include "lpastar.hpp"
+#include "utils.hpp"
+#include "wavefront.hpp"
+
+/**
+ * @brief a planner under test
+ */
+struct planner_S
+{
+    /** \brief name shown in the report */
+    std::string name;
+    /** \brief creates the planner on a map */
+    std::function<std::unique_ptr<planning::GPEngine_C>(std::shared_ptr<const OccupancyGrid_C>)> make;
+    /** \brief whether it also moves to the 4 corner neighbours */
+    bool eightConnected;
+    /** \brief whether its paths are the shortest, otherwise they are only no shorter */
+    bool optimal;
+};
+
+/**
+ * @brief checks a path returned by a planner
+ * @param grid - map
+ * @param path - path from goal to start
+ * @param start - start node
+ * @param goal - goal node
+ * @param eightConnected - whether moves to the corner neighbours are allowed
+ * @return whether the path is valid
+ */
+static bool validPath(const OccupancyGrid_C& grid, const std::vector<Node_C>& path, const Node_C& start,
+                      const Node_C& goal, const bool eightConnected)
+{
+    if (path.empty() || !compareCoordinates(path.front(), goal) || !compareCoordinates(path.back(), start))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        const Node_C& node = path[i];
+        if (checkOutsideBoundary(node, grid.rows(), grid.cols()) || node.id_ != node.x_ * grid.cols() + node.y_)
+        {
+            return false;
+        }
+        if (i + 1 == path.size())
+        {
+            break;
+        }
+        const int64_t dx = std::abs(node.x_ - path[i + 1].x_);
+        const int64_t dy = std::abs(node.y_ - path[i + 1].y_);
+        const bool neighbour = eightConnected ? (std::max(dx, dy) == 1) : (dx + dy == 1);
+        if (!neighbour || !planning::isTraversable(grid(node.x_, node.y_)) || node.pId_ != path[i + 1].id_)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    using map_T = std::shared_ptr<const OccupancyGrid_C>;
+    const std::vector<planner_S> planners = {
+        {"AStar_C", [](map_T m) { return std::make_unique<planning::AStar_C>(m); }, false, true},
+        {"AStar_C ALT",
+         [](map_T m) {
+             auto aStar = std::make_unique<planning::AStar_C>(m);
+             aStar->setLandmarks(planning::Landmarks_C::build(m, 4));
+             return aStar;
+         },
+         false, true},
+        {"AStar8_C", [](map_T m) { return std::make_unique<planning::AStar8_C>(m); }, true, true},
+        {"ARAStar_C", [](map_T m) { return std::make_unique<planning::ARAStar_C>(m); }, false, true},
+        {"ARAStar8_C", [](map_T m) { return std::make_unique<planning::ARAStar8_C>(m); }, true, true},
+        {"BiAStar_C", [](map_T m) { return std::make_unique<planning::BiAStar_C>(m); }, false, true},
+        {"BiAStar8_C", [](map_T m) { return std::make_unique<planning::BiAStar8_C>(m); }, true, true},
+        {"BiDijkstra_C", [](map_T m) { return std::make_unique<planning::BiDijkstra_C>(m); }, false, true},
+        {"DistanceField_C", [](map_T m) { return std::make_unique<planning::DistanceField_C>(m); }, false, true},
+        {"DStarLite_C", [](map_T m) { return std::make_unique<planning::DStarLite_C>(m); }, false, true},
+        {"HPA_C", [](map_T m) { return std::make_unique<planning::HPA_C>(m, 4); }, false, false},
+        {"JPS_C cell", [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_CELL); },
+         true, true},
+        {"JPS_C word", [](map_T m) { return std::make_unique<planning::JPS_C>(m, planning::JPS_C::SCAN_WORD); },
+         true, true},
+        {"LPAStar_C", [](map_T m) { return std::make_unique<planning::LPAStar_C>(m); }, false, true},
+        {"WavefrontField_C", [](map_T m) { return std::make_unique<planning::WavefrontField_C>(m); }, false, true},
+    };
+
+    constexpr uint32_t seed = 5;
+    constexpr size_t numQueries = 40;
+
+    std::vector<std::pair<std::string, map_T>> maps;
+    for (const auto& [rows, cols] : std::vector<std::pair<int64_t, int64_t>>{{6, 40}, {40, 6}, {13, 29}, {1, 70}})
+    {
+        for (const double density : {0.0, 0.15})
+        {
+            auto grid = std::make_shared<OccupancyGrid_C>(rows, cols, 0);
+            makeGrid(*grid, seed, density);
+            maps.emplace_back(std::to_string(rows) + "x" + std::to_string(cols) + " "
+                                  + std::to_string(density).substr(0, 4), grid);
+        }
+    }
+
+    int failures = 0;
+    for (const auto& [mapName, map] : maps)
+    {
+        planning::Dijkstra_C reference4(map);
+        planning::AStar8_C reference8(map);
+        for (const auto& planner : planners)
+        {
+            auto p = planner.make(map);
+            std::mt19937 eng(seed);
+            std::uniform_int_distribution<int64_t> row(0, map->rows() - 1);
+            std::uniform_int_distribution<int64_t> col(0, map->cols() - 1);
+            size_t numBad = 0;
+            size_t found = 0;
+            for (size_t q = 0; q < numQueries; q++)
+            {
+                const int64_t sx = row(eng);
+                const int64_t sy = col(eng);
+                const int64_t gx = row(eng);
+                const int64_t gy = col(eng);
+                if (!planning::isTraversable((*map)(sx, sy)) || !planning::isTraversable((*map)(gx, gy)))
+                {
+                    continue;
+                }
+                const Node_C start(sx, sy, 0, 0, map->index(sx, sy), map->index(sx, sy));
+                const Node_C goal(gx, gy, 0, 0, map->index(gx, gy), map->index(gx, gy));
+                const auto [refFound, refPath] = planner.eightConnected ? reference8.plan(start, goal)
+                                                                        : reference4.plan(start, goal);
+                const auto [pathFound, path] = p->plan(start, goal);
+                bool ok = (refFound == pathFound);
+                if (ok && pathFound)
+                {
+                    const double refCost = refPath.front().cost_;
+                    const double cost = path.front().cost_;
+                    ok = validPath(*map, path, start, goal, planner.eightConnected)
+                         && (planner.optimal ? std::fabs(cost - refCost) < 1e-6 : cost > refCost - 1e-6);
+                }
+                found += pathFound ? 1 : 0;
+                numBad += ok ? 0 : 1;
+            }
+            failures += (0 == numBad) ? 0 : 1;
+            std::cout << ((0 == numBad) ? "ok      " : "FAILED  ") << mapName << "  " << planner.name << ": "
+                      << numBad << " bad queries, " << found << " paths" << '\n';
+        }
+    }
+    return (0 == failures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}